@@ -34,7 +34,7 @@ void Skeleton::BoneAni::GetTransMatrix(float t, Matrix &mat) const
     }
     else
     {
-        //IMPROVEֲҹؼ֡
+        //IMPROVE：二分查找关键帧
         for(int i = 0; i != keyframes.size() - 1; ++i)
         {
             if(keyframes[i].time <= t && t <= keyframes[i + 1].time)
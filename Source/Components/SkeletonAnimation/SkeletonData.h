@@ -14,7 +14,7 @@ Created by AirGuanZ
 
 namespace Skeleton
 {
-    //һһؼ֡
+    //一块骨骼的一个关键帧数据
     struct Keyframe
     {
         float time;
@@ -24,7 +24,7 @@ namespace Skeleton
         Quaternion rotate;
     };
 
-    //һһ
+    //一块骨骼的一个动作
     struct BoneAni
     {
         void GetTransMatrix(float t, Matrix &mat) const;
@@ -42,7 +42,7 @@ namespace Skeleton
         std::vector<Keyframe> keyframes;
     };
 
-    //һϵйһ
+    //一系列骨骼的一个动作
     struct AniClip
     {
         void GetTransMatrix(float t, std::vector<Matrix> &mats) const;
@@ -64,7 +64,7 @@ namespace Skeleton
         float startTime, endTime;
     };
 
-    //һϵйһ鶯
+    //一系列骨骼的一组动作
     class Skeleton
     {
     public:
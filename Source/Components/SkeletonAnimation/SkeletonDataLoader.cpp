@@ -47,9 +47,9 @@ namespace
     }
 
     /*
-        ݹʽڵparentsйʾĹ
-        boneIdxڼ¼ֵ±ӳ
-        ûֵĽڵ㣬_AutoNamedBone_ + idxΪԶĽ
+        递归访问节点数，在parents中构造数组表示的骨骼树
+        boneIdx用于记录名字到骨骼下标的映射
+        对没有名字的节点，_AutoNamedBone_ + idx将作为自动命名的结果
     */
     bool ReadStaticSkeleton(aiNode *node,
                             std::vector<int> &parents,
@@ -59,14 +59,14 @@ namespace
     {
         assert(node != nullptr);
 
-        //ӵͬ
+        //不允许两个骨骼拥有相同的名字
         if(boneIdx.find(node->mName.C_Str()) != boneIdx.end())
         {
             errMsg = "Bone name repeated";
             return false;
         }
 
-        //ΪգԶ
+        //如果名字为空，就自动命名
         std::string finalName = GetBoneName(node->mName.C_Str(), idx);
         boneIdx[finalName] = idx;
 
@@ -75,7 +75,7 @@ namespace
 
         int thisIdx = idx++;
 
-        //ݹؽӽڵ
+        //递归地将子节点加入骨骼树
         for(unsigned int i = 0; i != node->mNumChildren; ++i)
         {
             if(!ReadStaticSkeleton(node->mChildren[i], parents,
@@ -86,7 +86,7 @@ namespace
         return true;
     }
 
-    //sceneжȡarmatureڵĹ
+    //从scene中读取armature节点的子树所描述的骨骼树
     bool InitStaticSkeletonFromAIScene(const aiScene *scene,
                                        Skeleton::Skeleton &skeleton,
                                        std::map<std::string, int> &boneIdx,
@@ -106,7 +106,7 @@ namespace
 
         for(unsigned int i = 0; i != armature->mNumChildren; ++i)
         {
-            //ÿӽڵ㣬-1Ϊdirect parentʾûиڵ
+            //对每个子节点，用-1作为direct parent，表示没有父节点
             if(!ReadStaticSkeleton(armature->mChildren[i], parents,
                                    boneIdx, idx, -1, errMsg))
                 return false;
@@ -119,8 +119,8 @@ namespace
         return true;
     }
 
-    //ȡеڵĹؼ֡
-    //Ҫÿؼ֡ͬʱ¼scaling, rotationtranslationϢ
+    //读取骨骼树中单个节点的关键帧序列
+    //要求每个关键帧同时记录scaling, rotation和translation信息
     bool ReadSkeletonAnimationForSingleNode(aiNodeAnim *nodeAni,
                                             float timeFactor,
                                             Skeleton::BoneAni &boneAni,
@@ -153,8 +153,8 @@ namespace
         return true;
     }
 
-    //sceneжȡУarmatureĸؼ֡
-    //Ҫÿؼ֡ͬʱ¼scaling, rotationtranslationϢ
+    //从scene中读取各动作中，armature骨骼树的各骨骼关键帧序列
+    //要求每个关键帧同时记录scaling, rotation和translation信息
     bool InitSkeletonAnimationFromAIScene(const aiScene *scene,
                                           std::set<std::string> &directBoneNames,
                                           float timeFactor,
@@ -174,16 +174,16 @@ namespace
             {
                 aiNodeAnim *nodeAni = ani->mChannels[i];
 
-                //Ķᱻ
+                //无名骨骼的动画会被忽略
                 if(nodeAni->mNodeName.C_Str()[0] == '\0')
                     continue;
 
-                //armatureǼϵĹᱻ
+                //不在armature骨架上的骨骼动画会被忽略
                 auto it = boneIdx.find(nodeAni->mNodeName.C_Str());
                 if(it == boneIdx.end())
                     continue;
 
-                //ȡĹؼ֡
+                //读取单个骨骼的关键帧序列
                 Skeleton::BoneAni &boneAni = aniClip.boneAnis[it->second];
                 if(!ReadSkeletonAnimationForSingleNode(ani->mChannels[i], timeFactor, boneAni, it->second))
                     return false;
@@ -227,11 +227,11 @@ bool Skeleton::SkeletonDataLoader::LoadFromRawFile(const std::wstring &filename,
 
     scene = importer.ReadFileFromMemory(
         fileBuf.data(), fileBuf.size(),
-        aiProcess_JoinIdenticalVertices |   //ʹindex buffer
-        aiProcess_Triangulate |             //ֻ
-        aiProcess_GenUVCoords |             //ǿʹUV
-        aiProcess_FlipUVs |                 //UVԭϽ
-        aiProcess_FlipWindingOrder          //CWΪ
+        aiProcess_JoinIdenticalVertices |   //便于使用index buffer
+        aiProcess_Triangulate |             //只允许三角形
+        aiProcess_GenUVCoords |             //强制使用UV
+        aiProcess_FlipUVs |                 //UV原点设置在左上角
+        aiProcess_FlipWindingOrder          //以CW为正面
     );
 
     if(!scene)
@@ -331,7 +331,7 @@ bool Skeleton::SkeletonDataLoader::LoadFromVWFile(const std::wstring &filename,
             goto FAILED;
         }
 
-        //ȡӳ䣺->ţ->
+        //取得映射：骨骼名字->骨骼编号，骨骼编号->父骨骼编号
         for(int boneIdx = 0; boneIdx < boneCount; ++boneIdx)
         {
             std::string idxStr = std::to_string(boneIdx);
@@ -356,7 +356,7 @@ bool Skeleton::SkeletonDataLoader::LoadFromVWFile(const std::wstring &filename,
 
         skeleton.Initialize(std::move(parents));
 
-        //
+        //骨骼动画名字
         for(int aniIdx = 0; aniIdx < animationCount; ++aniIdx)
         {
             std::string name = file("Animations", "AnimationName" + std::to_string(aniIdx));
@@ -368,7 +368,7 @@ bool Skeleton::SkeletonDataLoader::LoadFromVWFile(const std::wstring &filename,
             aniNames[aniIdx] = name;
         }
 
-        //ÿÿԶȡؼ֡
+        //对每个动画，遍历每个骨骼，尝试读取其关键帧序列
         for(int aniIdx = 0; aniIdx < animationCount; ++aniIdx)
         {
             AniClip aniClip;
@@ -417,14 +417,14 @@ bool Skeleton::SkeletonDataLoader::SaveToVWFile(const std::wstring &filename,
     if(!out)
         return false;
 
-    //ļͷ
+    //文件头
     out << "[Head]" << endl
         << endl
         << "BoneCount = " << skeleton.parents_.size() << endl
         << "AnimationCount = " << skeleton.aniClips_.size() << endl
         << endl;
 
-    //ֺͲιϵ
+    //骨骼名字和层次关系
     out << "[Bones]" << endl
         << endl;
     for(int i = 0; i != skeleton.parents_.size(); ++i)
@@ -434,7 +434,7 @@ bool Skeleton::SkeletonDataLoader::SaveToVWFile(const std::wstring &filename,
         out << "Name" << it.second << " = " << it.first << endl;
     out << endl;
 
-    //
+    //动画名
     out << "[Animations]" << endl
         << endl;
     std::vector<const AniClip*> anis;
@@ -445,7 +445,7 @@ bool Skeleton::SkeletonDataLoader::SaveToVWFile(const std::wstring &filename,
     }
     out << endl;
 
-    //ж͹ؼ֡
+    //遍历所有动画和骨骼，输出关键帧
     for(int aniIdx = 0; aniIdx != anis.size(); ++aniIdx)
     {
         const AniClip &aniClip = *anis[aniIdx];
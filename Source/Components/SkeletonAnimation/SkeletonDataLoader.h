@@ -16,7 +16,7 @@ namespace Skeleton
     class SkeletonDataLoader : public Singleton<SkeletonDataLoader>
     {
     public:
-        //ΪArmatureĽڵµĹϢ
+        //加载名为Armature的节点下的骨骼信息
         bool LoadFromRawFile(const std::wstring &filename,
                              float timeFactor,
                              Skeleton &skeleton,
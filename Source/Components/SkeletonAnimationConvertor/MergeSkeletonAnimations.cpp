@@ -14,7 +14,7 @@ bool SortBones(const std::map<std::string, int> &std,
     if(std.size() != act.size())
         return false;
 
-    //ָactidxΪibonestdǶ
+    //指出act中idx为i的bone在std中是多少
     std::map<int, int> act2std;
     act2std[-1] = -1;
     for(auto itAct : act)
@@ -29,12 +29,12 @@ bool SortBones(const std::map<std::string, int> &std,
     int boneCount = static_cast<int>(oldParents.size());
     std::vector<int> newParents(boneCount);
 
-    //parents
+    //构造新parents数组
     for(int actIdx = 0; actIdx < boneCount; ++actIdx)
         newParents[act2std[actIdx]] = act2std[oldParents[actIdx]];
     oldParents = std::move(newParents);
 
-    //ÿµbone anis
+    //对每个动画，构造新的bone anis
     for(auto &itClip : skt.GetAniClips())
     {
         Skeleton::AniClip &clip = itClip.second;
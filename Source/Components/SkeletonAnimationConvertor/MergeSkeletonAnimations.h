@@ -16,12 +16,12 @@ struct SingleAnimation
     std::map<std::string, int> boneMap;
 };
 
-//stdsktеĹ˳
+//根据std重排skt中的骨骼顺序
 bool SortBones(const std::map<std::string, int> &std,
                const std::map<std::string, int> &act,
                Skeleton::Skeleton &skt);
 
-//һskeletonϲһ
-//ҪparentsbongMapͬϲʵǶ
+//把一堆skeleton合并成一个
+//要求parents和bongMap相同，合并的实际上是动画
 bool MergeSkeletonData(std::vector<Skeleton::Skeleton> &skts,
                        Skeleton::Skeleton &output);
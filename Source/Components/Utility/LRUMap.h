@@ -0,0 +1,313 @@
+/*================================================================
+Filename: LRUMap.h
+Date: 2018.2.12
+Created by AirGuanZ
+================================================================*/
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+/*
+开放寻址（线性探测）的散列表 + 以下标串起来的双向链表
+    所有节点放在一个vector里，删除的节点进空闲链表复用，插入删除都不会单独分配内存
+    链表头部（Front）是最近使用的，尾部（Back）是最久未使用的
+    删除时做后移（backward shift），表里没有墓碑
+
+目前只有ChunkDataPool用它缓存区块数据：Get命中时移到头部，超出容量时从尾部PopBack
+*/
+template<typename KeyType, typename ValueType, typename HasherType = std::hash<KeyType>>
+class LRUMap
+{
+public:
+    using Key = KeyType;
+    using Value = ValueType;
+    using Hasher = HasherType;
+
+    LRUMap(void)
+        : head_(NIL), tail_(NIL), freeList_(NIL), size_(0), mask_(0)
+    {
+
+    }
+
+    LRUMap(LRUMap<KeyType, ValueType, HasherType> &&other)
+        : LRUMap()
+    {
+        Swap(other);
+    }
+
+    LRUMap<KeyType, ValueType, HasherType> &operator=(
+        LRUMap<KeyType, ValueType, HasherType> &&other)
+    {
+        Swap(other);
+        other.Clear();
+        return *this;
+    }
+
+    void Swap(LRUMap<KeyType, ValueType, HasherType> &other) noexcept
+    {
+        nodes_.swap(other.nodes_);
+        table_.swap(other.table_);
+        std::swap(head_, other.head_);
+        std::swap(tail_, other.tail_);
+        std::swap(freeList_, other.freeList_);
+        std::swap(size_, other.size_);
+        std::swap(mask_, other.mask_);
+    }
+
+    bool Empty(void) const noexcept
+    {
+        return size_ == 0;
+    }
+
+    size_t Size(void) const noexcept
+    {
+        return size_;
+    }
+
+    //预留至少能放下cnt个元素的空间
+    void Reserve(size_t cnt)
+    {
+        nodes_.reserve(cnt);
+        if(2 * cnt > table_.size())
+            Rehash(cnt);
+    }
+
+    bool Exists(const Key &key) const
+    {
+        return FindSlot(key) != NIL;
+    }
+
+    //找到时把它移到头部，并返回指向值的指针，否则返回nullptr
+    Value *Get(const Key &key)
+    {
+        std::int32_t slot = FindSlot(key);
+        if(slot == NIL)
+            return nullptr;
+        std::int32_t idx = table_[slot];
+        Unlink(idx);
+        LinkFront(idx);
+        return &nodes_[idx].value;
+    }
+
+    bool FindAndErase(const Key &key, ValueType &output)
+    {
+        std::int32_t slot = FindSlot(key);
+        if(slot == NIL)
+            return false;
+        std::int32_t idx = table_[slot];
+        output = std::move(nodes_[idx].value);
+        EraseSlot(slot);
+        FreeNode(idx);
+        return true;
+    }
+
+    ValueType &Back(void)
+    {
+        assert(!Empty());
+        return nodes_[tail_].value;
+    }
+
+    const Key &BackKey(void) const
+    {
+        assert(!Empty());
+        return nodes_[tail_].key;
+    }
+
+    void PopBack(void)
+    {
+        assert(!Empty());
+        std::int32_t idx = tail_;
+        EraseSlot(FindSlot(nodes_[idx].key));
+        FreeNode(idx);
+    }
+
+    ValueType &Front(void)
+    {
+        assert(!Empty());
+        return nodes_[head_].value;
+    }
+
+    //key不应已经存在
+    void PushFront(const Key &key, Value &&value)
+    {
+        Insert(key, std::move(value));
+    }
+
+    void PushFront(const Key &key, const Value &value)
+    {
+        Insert(key, Value(value));
+    }
+
+    //从头（最近）到尾（最久）遍历
+    template<typename FuncType>
+    void ForEach(FuncType &&func)
+    {
+        for(std::int32_t idx = head_; idx != NIL; idx = nodes_[idx].next)
+            func(nodes_[idx].value);
+    }
+
+    void Clear(void)
+    {
+        nodes_.clear();
+        std::fill(table_.begin(), table_.end(), NIL);
+        head_ = tail_ = freeList_ = NIL;
+        size_ = 0;
+    }
+
+private:
+    static constexpr std::int32_t NIL = -1;
+
+    struct Node
+    {
+        Key key;
+        Value value;
+        std::int32_t prev;
+        std::int32_t next;
+    };
+
+    //Hasher的结果不一定分布均匀（比如直接返回整数本身），再做一次乘法散列
+    static size_t Mix(size_t h)
+    {
+        std::uint64_t v = static_cast<std::uint64_t>(h) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(v ^ (v >> 29));
+    }
+
+    size_t HomeSlot(const Key &key) const
+    {
+        return Mix(Hasher()(key)) & mask_;
+    }
+
+    std::int32_t FindSlot(const Key &key) const
+    {
+        if(table_.empty())
+            return NIL;
+        for(size_t slot = HomeSlot(key); ; slot = (slot + 1) & mask_)
+        {
+            std::int32_t idx = table_[slot];
+            if(idx == NIL)
+                return NIL;
+            if(nodes_[idx].key == key)
+                return static_cast<std::int32_t>(slot);
+        }
+    }
+
+    void Insert(const Key &key, Value &&value)
+    {
+        assert(!Exists(key));
+        if(2 * (size_ + 1) > table_.size())
+            Rehash(size_ + 1);
+
+        std::int32_t idx;
+        if(freeList_ != NIL)
+        {
+            idx = freeList_;
+            freeList_ = nodes_[idx].next;
+            nodes_[idx].key = key;
+            nodes_[idx].value = std::move(value);
+        }
+        else
+        {
+            idx = static_cast<std::int32_t>(nodes_.size());
+            nodes_.push_back({ key, std::move(value), NIL, NIL });
+        }
+
+        size_t slot = HomeSlot(key);
+        while(table_[slot] != NIL)
+            slot = (slot + 1) & mask_;
+        table_[slot] = idx;
+
+        LinkFront(idx);
+        ++size_;
+    }
+
+    //线性探测的后移删除
+    void EraseSlot(std::int32_t slotToErase)
+    {
+        assert(slotToErase != NIL);
+        size_t hole = static_cast<size_t>(slotToErase);
+        size_t slot = hole;
+        for(;;)
+        {
+            slot = (slot + 1) & mask_;
+            std::int32_t idx = table_[slot];
+            if(idx == NIL)
+                break;
+            size_t home = HomeSlot(nodes_[idx].key);
+            //home不在(hole, slot]之间时，这个元素可以挪到hole处
+            if(((slot - home) & mask_) >= ((slot - hole) & mask_))
+            {
+                table_[hole] = idx;
+                hole = slot;
+            }
+        }
+        table_[hole] = NIL;
+    }
+
+    void FreeNode(std::int32_t idx)
+    {
+        Unlink(idx);
+        nodes_[idx].value = Value();
+        nodes_[idx].next = freeList_;
+        freeList_ = idx;
+        --size_;
+    }
+
+    void Rehash(size_t cnt)
+    {
+        size_t newSize = 16;
+        while(newSize < 2 * cnt)
+            newSize <<= 1;
+        table_.assign(newSize, NIL);
+        mask_ = newSize - 1;
+
+        for(std::int32_t idx = head_; idx != NIL; idx = nodes_[idx].next)
+        {
+            size_t slot = HomeSlot(nodes_[idx].key);
+            while(table_[slot] != NIL)
+                slot = (slot + 1) & mask_;
+            table_[slot] = idx;
+        }
+    }
+
+    void Unlink(std::int32_t idx)
+    {
+        Node &node = nodes_[idx];
+        if(node.prev != NIL)
+            nodes_[node.prev].next = node.next;
+        else
+            head_ = node.next;
+        if(node.next != NIL)
+            nodes_[node.next].prev = node.prev;
+        else
+            tail_ = node.prev;
+        node.prev = node.next = NIL;
+    }
+
+    void LinkFront(std::int32_t idx)
+    {
+        Node &node = nodes_[idx];
+        node.prev = NIL;
+        node.next = head_;
+        if(head_ != NIL)
+            nodes_[head_].prev = idx;
+        else
+            tail_ = idx;
+        head_ = idx;
+    }
+
+    std::vector<Node> nodes_;
+    std::vector<std::int32_t> table_;
+
+    std::int32_t head_;
+    std::int32_t tail_;
+    std::int32_t freeList_;
+
+    size_t size_;
+    size_t mask_;
+};
@@ -0,0 +1,107 @@
+/*================================================================
+Filename: MPSCQueue.h
+Date: 2018.2.13
+Created by AirGuanZ
+================================================================*/
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "Uncopiable.h"
+
+/*
+有界的多生产者单消费者无锁队列，元素按值存放在一个环形数组里
+    每个格子带一个序号，生产者用CAS抢占尾部的格子，写完数据后再发布序号，
+    消费者看到序号就知道数据已经写好了（Dmitry Vyukov的有界队列）
+    只有一个消费者，所以头部下标不需要原子操作
+
+容量会向上取整到2的幂，队列满时TryPush返回false，由调用者决定等待还是丢弃
+ValueType需要能默认构造和移动赋值
+*/
+template<typename ValueType>
+class MPSCQueue : public Uncopiable
+{
+public:
+    MPSCQueue(size_t capacity)
+        : head_(0), tail_(0)
+    {
+        size_t size = 2;
+        while(size < capacity)
+            size <<= 1;
+        mask_ = size - 1;
+
+        cells_ = std::make_unique<Cell[]>(size);
+        for(size_t i = 0; i != size; ++i)
+            cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    size_t Capacity(void) const
+    {
+        return mask_ + 1;
+    }
+
+    //可以在任意线程调用
+    bool TryPush(ValueType &&value)
+    {
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        Cell *cell;
+        for(;;)
+        {
+            cell = &cells_[pos & mask_];
+            size_t seq = cell->seq.load(std::memory_order_acquire);
+            std::intptr_t dif = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if(dif == 0)
+            {
+                if(tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if(dif < 0) //消费者还没取走一圈之前的数据，队列满了
+                return false;
+            else
+                pos = tail_.load(std::memory_order_relaxed);
+        }
+
+        cell->value = std::move(value);
+        cell->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool TryPush(const ValueType &value)
+    {
+        return TryPush(ValueType(value));
+    }
+
+    //只能在消费者线程调用
+    bool TryPop(ValueType &output)
+    {
+        Cell &cell = cells_[head_ & mask_];
+        if(cell.seq.load(std::memory_order_acquire) != head_ + 1)
+            return false;
+
+        output = std::move(cell.value);
+        cell.seq.store(head_ + mask_ + 1, std::memory_order_release);
+        ++head_;
+        return true;
+    }
+
+private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    struct Cell
+    {
+        std::atomic<size_t> seq;
+        ValueType value;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_;
+
+    //生产者和消费者各自频繁修改的下标放在不同的缓存行里
+    alignas(CACHE_LINE_SIZE) size_t head_;
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_;
+};
@@ -7,6 +7,7 @@ Created by AirGuanZ
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <sstream>
 #include <string>
 
@@ -32,23 +33,23 @@ inline std::string ToString(const Vector3 &vec)
     return sst.str();
 }
 
-//origindirϵһΪaccVķ
-//maxVΪӵõķȵ
-//ԭͳmaxVӰ
+//在origin的dir方向上叠加一个长度为accV的分量
+//并用maxV作为叠加得到的分量长度的上限
+//若分量长度原本就超过maxV，则不受影响
 //dir shall be normalized
 inline Vector3 CombineAcc(const Vector3 &origin, const Vector3 &dir, float accV, float maxV)
 {
-    //origindirϵķ
+    //origin在dir方向上的分量长度
     float oriDirLen = origin.Dot(dir);
-    //µdirϵķ
+    //新的dir方向上的分量长度
     float newDirLen = (std::max)(oriDirLen, (std::min)(oriDirLen + accV, maxV));
-    //ϳΪս
+    //合成为最终结果
     return (origin - oriDirLen * dir) + newDirLen * dir;
 }
 
-//origin-dirϵһΪaccVķ
-//minVΪӵõķȵ
-//ԭ͵minVӰ
+//在origin的-dir方向上叠加一个长度为accV的分量
+//并用minV作为叠加得到的分量长度的下限
+//若分量长度原本就低于minV，则不受影响
 //dir shall be normalized
 inline Vector3 CombineFric(const Vector3 &origin, const Vector3 &dir, float fric, float minV)
 {
@@ -97,7 +98,9 @@ struct IntVectorXZHasher
 {
     size_t operator()(const IntVectorXZ &v) const noexcept
     {
-        return std::hash<size_t>()((std::hash<int>()(v.x) ^ std::hash<int>()(v.z)) >> 2);
+        return std::hash<std::uint64_t>()(
+            (static_cast<std::uint64_t>(static_cast<std::uint32_t>(v.x)) << 32) |
+             static_cast<std::uint32_t>(v.z));
     }
 };
 
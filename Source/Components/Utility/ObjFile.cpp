@@ -60,7 +60,7 @@ bool ObjFile_PNT::LoadFromFile(const std::wstring &filename, float scale)
     std::string line;
     while(std::getline(fin, line))
     {
-        //кע
+        //跳过空行和注释
         if(line.empty() || line[0] == '#')
             continue;
 
@@ -20,25 +20,25 @@ public:
         Vector2 uv;
     };
 
-    /*  ע豻صģ͵ϵmagica voxel 0.99aͬ
-        Զת͵ͼѧϵʵ״
-        ͼĻļϵģ
+    /*  注意这里假设被加载的模型的坐标系和magica voxel 0.99a相同
+        会自动转换到典型的图形学右手系，而保持实际形状不变
+        画个图的话，文件坐标系假设是这样的：
                 z
                 |
                 |
                 *------- y
               /
            x /
-        صĽģ
+        加载的结果是这样的：
                 y
                 |
                 |
                 *------- x
               /
            z /
-        ʵ״ȫû
-        Զmagica voxelobjþˣ
-        Դobjעһϵ
+        而实际形状完全没变
+        所以对magica voxel导出的obj，放心用就行了；
+        对其他来源的obj，注意对照一下坐标系
     */
     bool LoadFromFile(const std::wstring &filename, float scale = 1.0f);
 
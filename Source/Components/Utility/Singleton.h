@@ -5,9 +5,9 @@ Created by AirGuanZ
 ================================================================*/
 
 /*
-    ̰߳ȫĵʵ
-    TӦpublicʽ̳Singleton<T>
-    ʵļд
+    线程安全的单例实现
+    单例类T应以public方式继承Singleton<T>
+    并在实现文件中写下
         SINGLETON_CLASS_DEFINITION(T);
 */
 
@@ -155,22 +155,66 @@ void Actor::UpdateState(float dT, const UserInput &uI, const EnvirInput &eI)
         &Actor::ApplyState_Jumping
     };
 
-    //״̬
+    //新状态
     State newState = (this->*actorUpdateStateFuncs[static_cast<int>(state_)])(uI, eI);
 
-    //״̬ı
+    //处理状态改变
     if(newState != state_)
         (this->*actorInitStateFuncs[static_cast<int>(newState)])(uI, eI);
 
-    //״̬actor
+    //根据状态更新actor其他属性
     (this->*actorApplyStateFuncs[static_cast<int>(state_)])(dT, uI, eI);
 }
 
-//IMPROVEײָʱλĿǰǱ
 void Actor::UpdateActorPosition(float dT, ChunkManager *ckMgr)
 {
     Vector3 oldPos = pos_, newPos = pos_ + dT * vel_;
 
+    Vector3 L(params_.collisionRadius, 0.0f, params_.collisionRadius);
+    Vector3 H(params_.collisionRadius, params_.collisionHeight, params_.collisionRadius);
+    Vector3 minPos((std::min)(oldPos.x, newPos.x), (std::min)(oldPos.y, newPos.y), (std::min)(oldPos.z, newPos.z));
+    Vector3 maxPos((std::max)(oldPos.x, newPos.x), (std::max)(oldPos.y, newPos.y), (std::max)(oldPos.z, newPos.z));
+    AABB area{ minPos - L, maxPos + H };
+
+    //碰撞检测把还没加载的区块当作实心，所以移动前移动范围内的区块必须都已加载：
+    //Freeze时冻结角色直到后台加载好，LoadNow时在主线程同步加载
+    bool frozen = false;
+    if(params_.unloadedChunkPolicy == UnloadedChunkPolicy::Freeze)
+        frozen = !ckMgr->IsAreaLoaded(area);
+    else
+        ckMgr->LoadArea(area);
+
+    if(frozen)
+        vel_ = Vector3(0.0f, 0.0f, 0.0f);
+    else
+        MoveWithCollision(dT, ckMgr);
+
+    //根据dstYaw和aclYaw的差距计算新的aclYaw
+
+    float deltaYaw = dstYaw_ - actYaw_;
+    while(deltaYaw > +PI) deltaYaw -= _2PI;
+    while(deltaYaw < -PI) deltaYaw += _2PI;
+
+    if(std::abs(deltaYaw) > 0.97f * PI)
+        actYaw_ = dstYaw_;
+    else
+    {
+        if(deltaYaw > 0.0f)
+            actYaw_ = (std::min)(actYaw_ + dT * params_.turningSpeed, actYaw_ + deltaYaw);
+        else
+            actYaw_ = (std::max)(actYaw_ - dT * params_.turningSpeed, actYaw_ + deltaYaw);
+    }
+
+    model_.SetTransform(
+        Matrix::CreateFromAxisAngle({ 0.0f, 1.0f, 0.0f }, -actYaw_) *
+        Matrix::CreateTranslation(Vector3(pos_.x, pos_.y + params_.modelYOffset, pos_.z)));
+}
+
+//IMPROVE：碰撞检测恢复时搜索合适位置目前是暴力的
+void Actor::MoveWithCollision(float dT, ChunkManager *ckMgr)
+{
+    Vector3 oldPos = pos_, newPos = pos_ + dT * vel_;
+
     std::vector<Vector3> tryList =
     {
         newPos,
@@ -207,15 +251,15 @@ void Actor::UpdateActorPosition(float dT, ChunkManager *ckMgr)
         ++pIdx;
     }
 
-    if(pos_.y == oldPos.y) //ֱӸֵõԾȷȽ
+    if(pos_.y == oldPos.y) //直接赋值得到，可以精确比较
     {
-        //ֱٶΪ0
-        //ݻָonGround
+        //置竖直速度为0
+        //根据恢复方向设置onGround
         vel_.y = 0.0f;
         if(newPos.y <= oldPos.y)
             onGround_ = true;
 
-        //oldPosnewPos֮һʵλ
+        //在oldPos和newPos之间搜索一个合适的位置
         constexpr int COLDEC_Y_SEGNUM = 20;
         float step = (newPos.y - oldPos.y) / COLDEC_Y_SEGNUM;
         float finalY = oldPos.y;
@@ -233,32 +277,12 @@ void Actor::UpdateActorPosition(float dT, ChunkManager *ckMgr)
 #endif
     }
 
-    //xzĴûô(sF)sߩ
+    //x和z方向的处理就没辣么精致啦(╯‵□′)╯︵┻━┻
 
     if(pos_.x == oldPos.x)
         vel_.x = 0.0f;
     if(pos_.z == oldPos.z)
         vel_.z = 0.0f;
-
-    //dstYawaclYawĲµaclYaw
-
-    float deltaYaw = dstYaw_ - actYaw_;
-    while(deltaYaw > +PI) deltaYaw -= _2PI;
-    while(deltaYaw < -PI) deltaYaw += _2PI;
-
-    if(std::abs(deltaYaw) > 0.97f * PI)
-        actYaw_ = dstYaw_;
-    else
-    {
-        if(deltaYaw > 0.0f)
-            actYaw_ = (std::min)(actYaw_ + dT * params_.turningSpeed, actYaw_ + deltaYaw);
-        else
-            actYaw_ = (std::max)(actYaw_ - dT * params_.turningSpeed, actYaw_ + deltaYaw);
-    }
-
-    model_.SetTransform(
-        Matrix::CreateFromAxisAngle({ 0.0f, 1.0f, 0.0f }, -actYaw_) *
-        Matrix::CreateTranslation(Vector3(pos_.x, pos_.y + params_.modelYOffset, pos_.z)));
 }
 
 void Actor::UpdateCameraPosition(float deltaT, ChunkManager *ckMgr)
@@ -412,7 +436,7 @@ namespace
         return movingYawOffsets[3 * (FB + 1) + (LR + 1)];
     }
 
-    //originȼfric
+    //将origin长度减少fric
     inline Vector3 ApplyFric(const Vector3 &origin, float fric)
     {
         Vector3 rt;
@@ -420,7 +444,7 @@ namespace
         return (std::max)(0.0f, origin.Length() - fric) * rt;
     }
 
-    //originxzƽϷĳȼfric
+    //将origin在xz平面上分量的长度减少fric
     inline Vector3 ApplyFricXZ(const Vector3 &ori, float fric)
     {
         Vector3 rtHor = ApplyFric(Vector3(ori.x, 0.0f, ori.z), fric);
@@ -430,35 +454,35 @@ namespace
 
 void Actor::ApplyState_Standing(float dT, const UserInput &uI, const EnvirInput &eI)
 {
-    //ٶ
+    //重力加速度
     vel_ = CombineAcc(vel_, params_.gravityDir, dT * params_.gravityAcl, params_.gravityMaxSpeed);
 
-    //վʱˮƽ
+    //站立时的水平阻力减速
     vel_ = ApplyFricXZ(vel_, dT * params_.standingFricAcl);
 }
 
 void Actor::ApplyState_Running(float dT, const UserInput &uI, const EnvirInput &eI)
 {
-    //ٶ
+    //重力加速度
     vel_ = CombineAcc(vel_, params_.gravityDir, dT * params_.gravityAcl, params_.gravityMaxSpeed);
 
     assert(HasMoving(uI));
     auto [FB, LR] = Get_FB_LR_Move(uI);
 
-    //µdstYaw
+    //新的dstYaw
     dstYaw_ = -camera_.GetYaw() + GetMovingYawOffsets(FB, LR);
 
-    //ƶ
+    //移动方向
     
     const Vector3 &camDir = camera_.GetDirection();
     Vector3 horMove = static_cast<float>(FB) * Vector3(camDir.x, 0.0f, camDir.z) +
                       static_cast<float>(LR) * Vector3(camDir.z, 0.0f, -camDir.x);
     horMove.Normalize();
 
-    //ƶٶȺӵٶ
-    //ƶõhorMove
+    //将移动加速度和阻力叠加到速度上
+    //移动加速作用到horMove方向上
 
-    //
+    //阻力叠加
     Vector3 fricDir = Vector3(vel_.x, 0.0f, vel_.z);
     if(fricDir.Length() > 1e-5f)
     {
@@ -466,31 +490,31 @@ void Actor::ApplyState_Running(float dT, const UserInput &uI, const EnvirInput &
         vel_ = CombineFric(vel_, fricDir, dT * params_.runningFricAcl, 0.0f);
     }
 
-    //ƶٶȵ
+    //移动速度叠加
     vel_ = CombineAcc(vel_, horMove, dT * params_.runningAcl, params_.runningSpeed);
 }
 
 void Actor::ApplyState_Walking(float dT, const UserInput &uI, const EnvirInput &eI)
 {
-    //ٶ
+    //重力加速度
     vel_ = CombineAcc(vel_, params_.gravityDir, dT * params_.gravityAcl, params_.gravityMaxSpeed);
 
     assert(HasMoving(uI));
     auto [FB, LR] = Get_FB_LR_Move(uI);
 
-    //µdstYaw
+    //新的dstYaw
     dstYaw_ = -camera_.GetYaw() + GetMovingYawOffsets(FB, LR);
 
-    //ƶٶ
+    //移动速度增量
 
     const Vector3 &camDir = camera_.GetDirection();
     Vector3 horMove = static_cast<float>(FB) * Vector3(camDir.x, 0.0f, camDir.z) +
                       static_cast<float>(LR) * Vector3(camDir.z, 0.0f, -camDir.x);
 
-    //ƶٶȺӵٶ
-    //ƶõhorMove
+    //将移动加速度和阻力叠加到速度上
+    //移动加速作用到horMove方向上
 
-    //
+    //阻力叠加
     Vector3 fricDir = Vector3(vel_.x, 0.0f, vel_.z);
     if(fricDir.Length() > 1e-5f)
     {
@@ -498,32 +522,32 @@ void Actor::ApplyState_Walking(float dT, const UserInput &uI, const EnvirInput &
         vel_ = CombineFric(vel_, fricDir, dT * params_.walkingFricAcl, 0.0f);
     }
 
-    //ƶٶȵ
+    //移动速度叠加
     horMove.Normalize();
     vel_ = CombineAcc(vel_, horMove, dT * params_.walkingAcl, params_.walkingSpeed);
 }
 
 void Actor::ApplyState_Jumping(float dT, const UserInput &uI, const EnvirInput &eI)
 {
-    //ٶ
+    //重力加速度
     vel_ = CombineAcc(vel_, params_.gravityDir, dT * params_.gravityAcl, params_.gravityMaxSpeed);
 
     auto [FB, LR] = Get_FB_LR_Move(uI);
 
-    //µdstYaw
+    //新的dstYaw
     if(FB || LR)
         dstYaw_ = -camera_.GetYaw() + GetMovingYawOffsets(FB, LR);
 
-    //ƶٶ
+    //移动速度增量
 
     const Vector3 &camDir = camera_.GetDirection();
     Vector3 horMove = static_cast<float>(FB) * Vector3(camDir.x, 0.0f, camDir.z) +
                       static_cast<float>(LR) * Vector3(camDir.z, 0.0f, -camDir.x);
 
-    //ƶٶȺӵٶ
-    //ƶõhorMove
+    //将移动加速度和阻力叠加到速度上
+    //移动加速作用到horMove方向上
 
-    //
+    //阻力叠加
     Vector3 fricDir = Vector3(vel_.x, 0.0f, vel_.z);
     if(fricDir.Length() > 1e-5f)
     {
@@ -531,7 +555,7 @@ void Actor::ApplyState_Jumping(float dT, const UserInput &uI, const EnvirInput &
         vel_ = CombineFric(vel_, fricDir, dT * params_.jumpingFricAcl, 0.0f);
     }
 
-    //ƶٶȵ
+    //移动速度叠加
     horMove.Normalize();
     vel_ = CombineAcc(vel_, horMove, dT * params_.jumpingAcl, params_.jumpingSpeed);
 }
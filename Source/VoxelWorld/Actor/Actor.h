@@ -26,65 +26,68 @@ namespace ActorAux
 {
     struct ActorParam
     {
-        //ܶԸٶ
+        //跑动的自给加速度
         float runningAcl = 0.0008f;
-        //ߵԸٶ
+        //行走的自给加速度
         float walkingAcl = 0.0007f;
-        //ԾԸٶ
+        //跳跃的自给加速度
         float jumpingAcl = 0.0007f;
 
-        //ܶԸٶ
+        //跑动自给速度上限
         float runningSpeed = 0.0085f;
-        //Ըٶ
+        //行走自给速度上限
         float walkingSpeed = 0.0045f;
-        //ԾԼٶ
+        //跳跃自己速度上限
         float jumpingSpeed = 0.0075f;
-        //Ըٶ
+        //飞行自给速度上限
         float flyingSpeed = 0.0f;
 
-        //վٶ
+        //站立阻力加速度
         float standingFricAcl = 0.001f;
-        //ܶٶ
+        //跑动阻力加速度
         float runningFricAcl = 0.001f;
-        //ٶ
+        //行走阻力加速度
         float walkingFricAcl = 0.001f;
-        //Ծٶ
+        //跳跃阻力加速度
         float jumpingFricAcl = 0.001f;
 
-        //ɫתٶ
+        //角色朝向转动速度
         float turningSpeed = 0.012f;
 
-        //תˮƽ
+        //摄像机旋转水平灵敏度
         float camMovXSpeed = 0.00075f;
-        //תֱ
+        //摄像机旋转垂直灵敏度
         float camMovYSpeed = 0.00075f;
 
-        //ɫӵ
+        //摄像机到角色视点距离
         float camDistance = 7.5f;
-        //ɫӵɫλõĸ߶ƫ
+        //角色视点距角色位置的高度偏移
         float camDstYOffset = 1.5f;
 
-        //ʱСֱн
+        //摄像机看向脚下时的最小垂直夹角
         float camDownReOffset = 0.02f;
-        //ʱСֱн
+        //摄像机看向天空时的最小垂直夹角
         float camUpReOffset = 0.02f;
 
-        //ɫײ뾶
+        //角色碰撞半径
         float collisionRadius = 0.2f;
-        //ɫײ߶
+        //角色碰撞高度
         float collisionHeight = 1.6f;
-        //ģλúͽɫλõĴֱƫ
+        //模型位置和角色位置的垂直偏移
         float modelYOffset = 0.4f;
 
-        //Ծٶ
+        //跳跃初速度
         float jumpInitVel = 0.035f;
 
-        //ٶȴС
+        //重力加速度大小
         float gravityAcl = 0.0002f;
-        //ٶȷ
+        //重力加速度方向
         Vector3 gravityDir = Vector3(0.0f, -1.0f, 0.0f);
-        //ٶ
+        //重力带来的最大速度
         float gravityMaxSpeed = 0.014f;
+
+        //将要经过的区块还没加载时：Freeze表示原地不动等它加载好，LoadNow表示立即同步加载
+        UnloadedChunkPolicy unloadedChunkPolicy = UnloadedChunkPolicy::Freeze;
     };
 
     struct UserInput
@@ -95,7 +98,7 @@ namespace ActorAux
         Vector3 msMov;
     };
 
-    //ĬϰӳȡUserInput
+    //以默认按键映射取得UserInput数据
     void DefaultUserInput(UserInput &userInput);
 
     struct EnvirInput
@@ -103,8 +106,8 @@ namespace ActorAux
         void Clear(void);
     };
 
-    //˵ĻActor::UpdateStateתҲҪ
-    //IMPROVE״̬
+    //这里改了的话Actor::UpdateState里的跳转表也要改
+    //IMPROVE：把状态机抽象出来
     enum class ActorState
     {
         Standing = 0,
@@ -142,16 +145,18 @@ public:
     const Vector3 &GetPosition(void) const { return pos_; }
 
 private:
-    //ӽת
+    //摄像机视角旋转
     void UpdateCameraDirection(const UserInput &uI);
-    //״̬Ӧ
+    //状态更新与应用
     void UpdateState(float dT, const UserInput &uI, const EnvirInput &eI);
-    //ٶȺײ½ɫλ
+    //根据速度和碰撞更新角色位置
     void UpdateActorPosition(float deltaT, ChunkManager *ckMgr);
-    //ݽɫλáӽǵȸλ
+    //UpdateActorPosition中和碰撞相关的部分
+    void MoveWithCollision(float deltaT, ChunkManager *ckMgr);
+    //根据角色位置、摄像机视角等更新摄像机位置
     void UpdateCameraPosition(float deltaT, ChunkManager *ckMgr);
 
-    //״̬ʼתЧ
+    //状态初始化、转换和生效
 
     void InitState_Standing(const UserInput &uI, const EnvirInput &eI);
     void InitState_Running (const UserInput &uI, const EnvirInput &eI);
@@ -171,14 +176,14 @@ private:
 private:
     State state_;
 
-    //ط
+    //落地否
     bool onGround_;
 
-    //λúͳ
+    //位置和朝向
     Vector3 pos_;
     float actYaw_, dstYaw_;
 
-    //ٶ
+    //速度
     Vector3 vel_;
 
     Params params_;
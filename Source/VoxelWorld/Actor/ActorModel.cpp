@@ -284,7 +284,7 @@ void ActorModel::Render(const Camera &cam)
 
 bool ActorModel::End(void) const
 {
-    //ѭ޽֮
+    //循环动画永无结束之日
     if(aniClipLoop_)
         return false;
 
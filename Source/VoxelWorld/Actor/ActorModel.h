@@ -66,8 +66,8 @@ private:
 
     std::vector<ActorModelComponent> meshes_;
 
-    Skeleton::Skeleton skeleton_;   //
-    std::string currentAniClip_;    //ǰ
-    bool aniClipLoop_;              //Ƿѭ
-    float t_;                       //ʱ
+    Skeleton::Skeleton skeleton_;   //骨骼数据
+    std::string currentAniClip_;    //当前动作
+    bool aniClipLoop_;              //是否循环
+    float t_;                       //播放时间
 };
@@ -65,17 +65,17 @@ void Actor::UpdateActorPosition(float deltaT, ChunkManager *ckMgr)
 
     Vector3 dir = camera_.GetDirection();
 
-    //ƶǰλ꣬ײָ
+    //移动前备份位置坐标，用于其后的碰撞恢复
     Vector3 oldPos = pos_;
 
-    //ֱƶ
+    //垂直移动
 
     if(input.IsKeyDown(VK_SPACE))
         pos_.y += 16.66f * flyUpSpeed_;
     if(input.IsKeyDown(VK_LSHIFT))
         pos_.y -= 16.66f * flyDownSpeed_;
 
-    //ˮƽƶ
+    //水平移动
 
     Vector3 horDir = { dir.x, 0.0f, dir.z };
     Vector3 horLeftDir = { horDir.z, 0.0f, -horDir.x };
@@ -109,7 +109,7 @@ void Actor::UpdateActorPosition(float deltaT, ChunkManager *ckMgr)
     if(input.IsKeyDown(VK_LCONTROL))
         pos_ += horMoveSpeed_ * horMove * (16.66f * 4.0f);
 
-    //ײ
+    //碰撞检测
 
     std::vector<Vector3> tryList =
     {
@@ -123,7 +123,7 @@ void Actor::UpdateActorPosition(float deltaT, ChunkManager *ckMgr)
         oldPos
     };
 
-    //һλΪλãᷢײ
+    //将一个位置设置为摄像机新位置，若它不会发生碰撞
     auto TryPos = [&](const Vector3 &p) -> bool
     {
         if(!ckMgr->DetectCollision(AABB{ p - Vector3{ 0.2f, 0.4f, 0.2f },
@@ -141,7 +141,7 @@ void Actor::UpdateActorPosition(float deltaT, ChunkManager *ckMgr)
             break;
     }
 
-    //dstYawactYawı仯
+    //根据dstYaw计算actYaw的变化
 
     float deltaYaw = dstYaw_ - actYaw_;
     while(deltaYaw > DirectX::XM_PI)
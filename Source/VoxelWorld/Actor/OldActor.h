@@ -16,9 +16,9 @@ Created by AirGuanZ
 #include "ActorModel.h"
 
 /*
-    Actor״̬Ͷ֯ƣ
-        ڲ״̬֯ģͶл͸·װ
-        ڲ״̬תUserInputEnvirInputƶǰεMonomorphismһ
+    Actor状态和动画的组织设计：
+        内部用状态机组织，模型动画的切换和更新封装出来
+        内部状态的转移由UserInput和EnvirInput来推动（和以前尴尬的Monomorphism一样）
 */
 
 class Actor
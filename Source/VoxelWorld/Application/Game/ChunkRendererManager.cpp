@@ -3,6 +3,7 @@ Filename: ChunkRendererManager.cpp
 Date: 2018.2.25
 Created by AirGuanZ
 ================================================================*/
+#include <Chunk/QuadIndexBuffer.h>
 #include <Resource/ResourceName.h>
 #include <Window/Window.h>
 
@@ -14,6 +15,7 @@ ChunkRendererManager::ChunkRendererManager(void)
     DC_ = nullptr;
 
     basicUniform_Trans_    = nullptr;
+    basicUniform_Section_  = nullptr;
     basicUniform_Sunlight_ = nullptr;
     basicUniform_Fog_      = nullptr;
     basicUniform_Tex_      = nullptr;
@@ -73,6 +75,13 @@ bool ChunkRendererManager::Initialize(std::string &errMsg)
         return false;
     }
 
+    if(!QuadIndexBuffer::GetInstance().Initialize())
+    {
+        errMsg = "Failed to create shared quad index buffer for chunk rendering";
+        Destroy();
+        return false;
+    }
+
     sampler_ = Sampler();
     if(!sampler_)
     {
@@ -91,6 +100,7 @@ bool ChunkRendererManager::Initialize(std::string &errMsg)
     liquidUniforms_->GetShaderSampler<SS_PS>("sam")->SetSampler(sampler_);
 
     basicUniform_Trans_ = basicUniforms_->GetConstantBuffer<SS_VS, BasicVSCBTrans>(dev, "Trans");
+    basicUniform_Section_ = basicUniforms_->GetConstantBuffer<SS_VS, BasicVSCBSection, true>(dev, "Section");
     basicUniform_Fog_ = basicUniforms_->GetConstantBuffer<SS_PS, BasicPSCBFog>(dev, "Fog");
     basicUniform_Sunlight_ = basicUniforms_->GetConstantBuffer<SS_PS, BasicPSCBSunlight>(dev, "Sunlight");
     basicUniform_Tex_ = basicUniforms_->GetShaderResource<SS_PS>("tex");
@@ -126,9 +136,12 @@ void ChunkRendererManager::Destroy(void)
         tex.Destroy();
     liquidUniforms_.reset();
 
+    QuadIndexBuffer::GetInstance().Destroy();
+
     sampler_ = Sampler(D3DObj_Noinit());
 
     basicUniform_Trans_    = nullptr;
+    basicUniform_Section_  = nullptr;
     basicUniform_Sunlight_ = nullptr;
     basicUniform_Fog_      = nullptr;
     basicUniform_Tex_      = nullptr;
@@ -174,7 +187,11 @@ void ChunkRendererManager::Render(ChunkSectionRenderQueue &renderQueue)
 
         basicRenderer_.Begin();
         basicUniforms_->Bind(DC_);
-        renderQueue.basic[i].Render();
+        //常量缓冲已经绑定，每次绘制前只需要改写内容
+        renderQueue.basic[i].Render([&](const Vector3 &sectionOrigin)
+        {
+            basicUniform_Section_->SetBufferData(DC_, { sectionOrigin });
+        });
         basicUniforms_->Unbind(DC_);
         basicRenderer_.End();
     }
@@ -40,6 +40,10 @@ private:
     {
         Matrix VP;
     };
+    struct BasicVSCBSection
+    {
+        alignas(16) Vector3 sectionOrigin;
+    };
     struct BasicPSCBSunlight
     {
         alignas(16) Vector3 sunlight;
@@ -89,10 +93,11 @@ private:
     BasicRenderer basicRenderer_;
     std::array<Texture2D, BASIC_RENDERER_TEXTURE_NUM> basicRendererTextures_;
     std::unique_ptr<BasicRenderer::Uniforms> basicUniforms_;
-    OWE::ConstantBufferObject<SS_VS, BasicVSCBTrans>    *basicUniform_Trans_ = nullptr;
-    OWE::ConstantBufferObject<SS_PS, BasicPSCBSunlight> *basicUniform_Sunlight_ = nullptr;
-    OWE::ConstantBufferObject<SS_PS, BasicPSCBFog>      *basicUniform_Fog_ = nullptr;
-    OWE::ShaderResourceObject<SS_PS>                    *basicUniform_Tex_ = nullptr;
+    OWE::ConstantBufferObject<SS_VS, BasicVSCBTrans>         *basicUniform_Trans_ = nullptr;
+    OWE::ConstantBufferObject<SS_VS, BasicVSCBSection, true> *basicUniform_Section_ = nullptr;
+    OWE::ConstantBufferObject<SS_PS, BasicPSCBSunlight>      *basicUniform_Sunlight_ = nullptr;
+    OWE::ConstantBufferObject<SS_PS, BasicPSCBFog>           *basicUniform_Fog_ = nullptr;
+    OWE::ShaderResourceObject<SS_PS>                         *basicUniform_Tex_ = nullptr;
 
     CarveRenderer carveRenderer_;
     std::array<Texture2D, CARVE_RENDERER_TEXTURE_NUM> carveRendererTextures_;
@@ -7,6 +7,9 @@ Created by AirGuanZ
 
 #include <Utility/Math.h>
 
+#include <Chunk/ChunkLoader.h>
+#include <Chunk/ChunkModelBuilder.h>
+#include <Chunk/LightUpdater.h>
 #include <Input/InputManager.h>
 #include <Screen/GUISystem.h>
 
@@ -19,12 +22,20 @@ public:
         bool actorOnGround;
         Vector3 actorPos;
         Vector3 camPos;
+
+        //只在窗口可见时填写
+        ChunkLoaderStats loaderStats;
+        LightUpdateStats lightStats;
+        ChunkMeshStats meshStats;
     };
 
     DebugWindow(void)
     {
         info_.actorOnGround = false;
         info_.FPS = 0.0f;
+        info_.loaderStats = { };
+        info_.lightStats = { };
+        info_.meshStats = { };
 
         openCloseKey_ = VK_F3;
         visible_ = false;
@@ -35,6 +46,11 @@ public:
         info_ = info;
     }
 
+    bool IsVisible(void) const
+    {
+        return visible_;
+    }
+
     void Update(InputManager &input)
     {
         if(input.IsKeyPressed(openCloseKey_))
@@ -48,7 +64,7 @@ public:
 
         GUI &gui = GUI::GetInstance();
 
-        ImGui::SetNextWindowSize(ImVec2(400.0f, 150.0f));
+        ImGui::SetNextWindowSize(ImVec2(400.0f, 300.0f));
         if(ImGui::Begin("Debug", nullptr, ImGuiWindowFlags_NoResize |
                                           ImGuiWindowFlags_NoMove |
                                           ImGuiWindowFlags_NoCollapse))
@@ -60,6 +76,40 @@ public:
             ImGui::Text(("Actor Position: "  + ToString(info_.actorPos)).c_str());
             ImGui::Text(("Camera Position: " + ToString(info_.camPos)).c_str());
 
+            //每个阶段：排队 / 执行中 / 等待依赖
+            const char *stageNames[] = { "Generate", "Light", "Mesh" };
+            for(int stage = 0; stage != CHUNK_LOADER_STAGE_NUM; ++stage)
+            {
+                const ChunkLoaderStats &st = info_.loaderStats;
+                ImGui::Text((std::string(stageNames[stage]) + ": " +
+                             std::to_string(st.queued[stage]) + " / " +
+                             std::to_string(st.running[stage]) + " / " +
+                             std::to_string(st.waiting[stage])).c_str());
+            }
+
+            //最近一次方块修改的光照更新：清零 / 传播 / 改变，耗时
+            const LightUpdateStats &ls = info_.lightStats;
+            ImGui::Text(("Light update: " + std::to_string(ls.removed) + " / " +
+                                            std::to_string(ls.propagated) + " / " +
+                                            std::to_string(ls.changed) + ", " +
+                                            std::to_string(ls.milliseconds) + "ms").c_str());
+
+            //section模型的平均顶点数、耗时和CPU上的几何数据量，切换建模方式时重新统计
+            const ChunkMeshStats &ms = info_.meshStats;
+            if(ms.sections)
+            {
+                ImGui::Text(("Mesh: " + std::to_string(ms.basicVertices / ms.sections) + " vertices, " +
+                                        std::to_string(ms.milliseconds / ms.sections) + "ms per section").c_str());
+                ImGui::Text(("Mesh memory: " + std::to_string(ms.geometryBytes / ms.sections) + " bytes per section, " +
+                                               std::to_string(sizeof(BasicModel::Vertex)) + " bytes per basic vertex").c_str());
+            }
+            bool greedy = IsGreedyMeshingEnabled();
+            if(ImGui::Checkbox("Greedy meshing", &greedy))
+            {
+                SetGreedyMeshingEnabled(greedy);
+                ResetChunkMeshStats();
+            }
+
             gui.PopFont();
         }
         ImGui::End();
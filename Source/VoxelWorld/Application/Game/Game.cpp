@@ -100,11 +100,16 @@ AppState Game::Run(void)
         debugInfo.actorOnGround = world_->GetActor().OnGround();
         debugInfo.actorPos      = world_->GetActor().GetPosition();
         debugInfo.camPos        = world_->GetActor().GetCameraPosition();
+        debugInfo.loaderStats   = { };
+        debugInfo.lightStats    = world_->GetChunkManager().GetLightUpdateStats();
+        debugInfo.meshStats     = GetChunkMeshStats();
+        if(mainDebugWin_.IsVisible())
+            debugInfo.loaderStats = world_->GetChunkManager().GetLoaderStats();
 
         mainDebugWin_.SetInfo(debugInfo);
         mainDebugWin_.Update(input_);
 
-        //ʱͱɫ
+        //根据时间计算天光和背景色
         daynightT += input_.IsKeyDown('T') ? 0.01f : 0.0001f;
         float absdnt = 0.5f * (std::max)((std::min)(2.0f * std::cos(daynightT), 1.0f), -1.0f) + 0.5f;
         Vector3 sunlight = { absdnt, absdnt, absdnt };
@@ -113,34 +118,34 @@ AppState Game::Run(void)
         win_.ClearRenderTarget();
         win_.ClearDepthStencil();
 
-        //ǿ
+        //天光强度设置
         ckRendererMgr_.SetSunlight(sunlight);
 
-        //
+        //雾设置
         fogStart_ = (std::min)(fogStart_ + 0.12f, appConf_.maxFogStart);
         fogRange_ = (std::min)(fogRange_ + 0.12f, appConf_.maxFogRange);
         ckRendererMgr_.SetFog(fogStart_, fogRange_, { 0.0f, absdnt, absdnt }, world_->GetActor().GetCameraPosition());
 
-        //
+        //世界更新
         world_->Update(16.6667f);
 
-        //ύȾ
+        //提交区块渲染任务
         world_->Render(&renderQueue);
 
-        //Ⱦ
+        //渲染世界
         ckRendererMgr_.SetTrans(world_->GetActor().GetCamera().GetViewProjMatrix().Transpose());
         ckRendererMgr_.Render(renderQueue);
 
-        //Ⱦɫ
+        //渲染角色
         world_->GetActor().Render();
 
-        //׼
+        //绘制准星
         crosshair_.Draw(&immScr2D_);
 
-        //debugڻ
+        //debug窗口绘制
         mainDebugWin_.Render();
 
-        //GUI
+        //绘制GUI
         gui_.Render();
 
         //win_.SetVsync(false);
@@ -14,7 +14,7 @@ Created by AirGuanZ
 
 #include "BlockInfo.h"
 
-//red, green, blue, sunlightĸÿλ
+//red, green, blue, sunlight四个分量，每个分量四位
 //red: 12-15
 //green: 8-11
 //blue: 4-7
@@ -33,7 +33,7 @@ enum BlockFace : std::uint8_t
 struct Block
 {
     BlockType type = BlockType::Air;
-    //עȲǷ鱾ȣǾ
+    //注意这里的亮度不是方块本身的亮度，而是经由自身流出的亮度
     BlockLight light = 0;
 };
 
@@ -64,22 +64,63 @@ inline Color LightToRGBA(BlockLight rgbs)
              LightToFloat(GetSunlight(rgbs)) };
 }
 
+/*
+SWAR：把一个整数看成若干个四位的分量，所有分量一起做运算
+    减法时先把每个分量的最高位置1、减数的最高位清0，这样低三位的借位到不了相邻分量，
+    最高位再单独用异或修正；每个分量的最高位是否向外借位，就说明这个分量是否小于零
+*/
+namespace BlockLightSWAR
+{
+    template<typename T>
+    constexpr T NIBBLE_LOW_BITS = static_cast<T>(~T(0)) / 0x0F;      //0x1111...
+
+    template<typename T>
+    constexpr T NIBBLE_HIGH_BITS = static_cast<T>(NIBBLE_LOW_BITS<T> << 3); //0x8888...
+
+    //每个分量分别计算max(a - b, 0)
+    template<typename T>
+    inline T SaturatingSub(T a, T b)
+    {
+        static_assert(std::is_unsigned_v<T>, "SWAR operand must be unsigned");
+        constexpr T H = NIBBLE_HIGH_BITS<T>;
+        T diff   = static_cast<T>(((a | H) - (b & static_cast<T>(~H))) ^ ((a ^ static_cast<T>(~b)) & H));
+        T borrow = static_cast<T>(((static_cast<T>(~a) & b) | (static_cast<T>(~(a ^ b)) & diff)) & H);
+        return static_cast<T>(diff & ~((borrow >> 3) * LIGHT_COMPONENT_MAX));
+    }
+
+    //每个分量分别计算max(a, b)
+    //a - b饱和后再加上b，每个分量的和都不超过LIGHT_COMPONENT_MAX，不会进位
+    template<typename T>
+    inline T Max(T a, T b)
+    {
+        return static_cast<T>(b + SaturatingSub(a, b));
+    }
+
+    //把衰减量复制到每个分量上，超过LIGHT_COMPONENT_MAX的衰减量和LIGHT_COMPONENT_MAX等价
+    template<typename T>
+    inline T Broadcast(int dec)
+    {
+        return static_cast<T>(NIBBLE_LOW_BITS<T> *
+            static_cast<T>((std::min)((std::max)(dec, 0), static_cast<int>(LIGHT_COMPONENT_MAX))));
+    }
+}
+
 inline BlockLight BlockLightMax(BlockLight lhs, BlockLight rhs)
 {
-    return MakeLight(
-        (std::max)(GetRed(lhs),      GetRed(rhs)),
-        (std::max)(GetGreen(lhs),    GetGreen(rhs)),
-        (std::max)(GetBlue(lhs),     GetBlue(rhs)),
-        (std::max)(GetSunlight(lhs), GetSunlight(rhs)));
+    return BlockLightSWAR::Max<BlockLight>(lhs, rhs);
+}
+
+inline BlockLight BlockLightMinus(BlockLight bl, int dec)
+{
+    return BlockLightSWAR::SaturatingSub<BlockLight>(bl, BlockLightSWAR::Broadcast<BlockLight>(dec));
 }
 
-inline BlockLight BlockLightMinus(BlockLight bl, std::uint8_t dec)
+//把四个分量分别放进6位：red 18-23, green 12-17, blue 6-11, sunlight 0-5
+//四个展开后的光照直接相加不会溢出，BasicRenderer的打包顶点存的就是这样的和
+inline std::uint32_t SpreadBlockLight(BlockLight bl)
 {
-    return MakeLight(
-        static_cast<std::uint8_t>((std::max)(GetRed(bl) - dec,      static_cast<int>(LIGHT_COMPONENT_MIN))),
-        static_cast<std::uint8_t>((std::max)(GetGreen(bl) - dec,    static_cast<int>(LIGHT_COMPONENT_MIN))),
-        static_cast<std::uint8_t>((std::max)(GetBlue(bl) - dec,     static_cast<int>(LIGHT_COMPONENT_MIN))),
-        static_cast<std::uint8_t>((std::max)(GetSunlight(bl) - dec, static_cast<int>(LIGHT_COMPONENT_MIN))));
+    std::uint32_t l = bl;
+    return ((l & 0xF000) << 6) | ((l & 0x0F00) << 4) | ((l & 0x00F0) << 2) | (l & 0x000F);
 }
 
 constexpr BlockLight LIGHT_ALL_MIN = MakeLight(LIGHT_COMPONENT_MIN, LIGHT_COMPONENT_MIN,
@@ -0,0 +1,61 @@
+/*================================================================
+Filename: BlockAO.h
+Date: 2018.2.20
+Created by AirGuanZ
+================================================================*/
+#pragma once
+
+#include <cstdint>
+
+#include <Utility/Math.h>
+
+#include "Block.h"
+
+constexpr float BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO = 0.93f;
+
+//BasicRenderer的打包顶点中的光照，四个格子的光照按分量相加，由顶点着色器换算成和BlockAO相同的颜色
+inline std::uint32_t BlockLightSum(BlockLight l0, BlockLight l1, BlockLight l2, BlockLight l3)
+{
+    return SpreadBlockLight(l0) + SpreadBlockLight(l1) + SpreadBlockLight(l2) + SpreadBlockLight(l3);
+}
+
+/*
+顶点AO颜色的查找表
+    原来的做法是把四个格子的光照换成Color再平均，每个分量是
+        0.15 + 0.85 * 0.25 * ((c0 + 0.5) + (c1 + 0.5) + (c2 + 0.5) + (c3 + 0.5)) / (LIGHT_COMPONENT_MAX + 0.5)
+    只和四个分量之和s有关，s在[0, 60]内，所以预先算好每个s对应的值，
+    BlockLightSum一次求出四个分量各自的和，之后每个分量查一次表，不再有浮点运算
+    side是乘上BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO之后的表，和BasicRenderer顶点着色器中的公式相同
+*/
+constexpr int BLOCK_AO_SUM_MAX = 4 * LIGHT_COMPONENT_MAX;
+
+struct BlockAOTable
+{
+    float top[BLOCK_AO_SUM_MAX + 1];
+    float side[BLOCK_AO_SUM_MAX + 1];
+
+    constexpr BlockAOTable(void)
+        : top(), side()
+    {
+        for(int s = 0; s <= BLOCK_AO_SUM_MAX; ++s)
+        {
+            top[s] = 0.15f + 0.85f * 0.25f * (s + 2.0f) / (LIGHT_COMPONENT_MAX + 0.5f);
+            side[s] = BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * top[s];
+        }
+    }
+};
+
+constexpr BlockAOTable BLOCK_AO_TABLE;
+
+struct VertexLight
+{
+    Vector3 lightColor;
+    float sunlight;
+};
+
+//lightSum是BlockLightSum的结果，table是BLOCK_AO_TABLE.top或.side
+inline VertexLight BlockAO(std::uint32_t lightSum, const float *table)
+{
+    return { { table[(lightSum >> 18) & 0x3F], table[(lightSum >> 12) & 0x3F], table[(lightSum >> 6) & 0x3F] },
+             table[lightSum & 0x3F] };
+}
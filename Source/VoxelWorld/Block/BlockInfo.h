@@ -71,8 +71,8 @@ struct BlockInfo
     bool isSolid;
     bool isRenderable;
 
-    //÷ʱܷ񸲸
-    //͵أˮtrueʯͷfalse
+    //放置方块的时候能否覆盖
+    //典型地，空气和水是true，石头是false
     bool isCoverable;
 
     bool isGlow;
@@ -84,19 +84,19 @@ struct BlockInfo
 
     union
     {
-        //BasicRenderer, BoxtexԼϵ
-        //0tex
-        //1-6+x, -x, +y, -y, +z, -z
+        //BasicRenderer, Box的六个面的tex编号以及其上的坐标
+        //0：tex编号
+        //1-6：+x, -x, +y, -y, +z, -z
         int basicBoxTexPos[7];
 
         int carveBoxTexPos[7];
 
-        //CarveRenderer, CrosstexԼϵ
-        //0tex
-        //1-2λ
+        //CarveRenderer, Cross的两个面的tex编号以及其上的坐标
+        //0：tex编号
+        //1-2：两个面位置坐标
         int carveCrossTexPos[3];
 
-        //LiquidRendererLiquidtexԼϵ
+        //LiquidRenderer，Liquid的六个面的tex编号以及其上的坐标
         int transLiquidTexPos[7];
     };
 };
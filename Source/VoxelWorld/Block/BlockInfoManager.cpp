@@ -14,7 +14,7 @@ Created by AirGuanZ
 
 SINGLETON_CLASS_DEFINITION(BlockInfoManager);
 
-//IMPROVEӲΪļм
+//IMPROVE：硬编码改为从配置文件中加载
 BlockInfoManager::BlockInfoManager(void)
 {
     info_ = {
@@ -219,6 +219,33 @@ BlockInfoManager::BlockInfoManager(void)
     SetCarveCrossTexPos(BlockType::Flower,       0, 2, 2);
     SetCarveCrossTexPos(BlockType::DriedGrass,   0, 3, 3);
     SetLiquidTexPos(BlockType::Water,            0, 0, 0, 0, 0, 0, 0);
+
+    InitFaceVisibleMask();
+}
+
+void BlockInfoManager::InitFaceVisibleMask(void)
+{
+    //和BlockFace的顺序对应
+    const IntVector3 normals[6] =
+    {
+        { 1, 0, 0 }, { -1, 0, 0 },
+        { 0, 1, 0 }, { 0, -1, 0 },
+        { 0, 0, 1 }, { 0, 0, -1 }
+    };
+
+    for(int face = 0; face != 6; ++face)
+    {
+        for(int dst = 0; dst != Blk2Int(BlockType::BlockTypeNum); ++dst)
+        {
+            std::uint32_t mask = 0;
+            for(int nei = 0; nei != Blk2Int(BlockType::BlockTypeNum); ++nei)
+            {
+                if(IsFaceVisible(Int2Blk(dst), Int2Blk(nei), { 0, 0, 0 }, normals[face]))
+                    mask |= 1u << nei;
+            }
+            faceVisibleMask_[face][dst] = mask;
+        }
+    }
 }
 
 const BlockInfo &BlockInfoManager::GetBlockInfo(BlockType type) const
@@ -230,7 +257,7 @@ const BlockInfo &BlockInfoManager::GetBlockInfo(BlockType type) const
 bool BlockInfoManager::IsFaceVisible(BlockType dst, BlockType neighbor,
                                      const IntVector3 &posDst, const IntVector3 &posNei) const
 {
-    const BlockInfo &infoDst = info_[Blk2Int(dst)], infoNei = info_[Blk2Int(neighbor)];
+    const BlockInfo &infoDst = info_[Blk2Int(dst)], &infoNei = info_[Blk2Int(neighbor)];
     if(infoDst.renderer == BlockRenderer::Null)
         return false;
     if(infoNei.renderer == BlockRenderer::Null)
@@ -5,8 +5,11 @@ Created by AirGuanZ
 ================================================================*/
 #pragma once
 
+#include <cstdint>
+
 #include <Utility/Singleton.h>
 
+#include "Block.h"
 #include "BlockInfo.h"
 
 class BlockInfoManager : public Singleton<BlockInfoManager>
@@ -19,6 +22,13 @@ public:
     bool IsFaceVisible(BlockType dst, BlockType neighbor,
                        const IntVector3 &posDst, const IntVector3 &posNei) const;
 
+    //dst在face方向上的邻居为neighbor时，dst的这个面是否可见
+    //和IsFaceVisible(dst, neighbor, { 0, 0, 0 }, face的法线)相同，构造时就查好了所有组合
+    bool IsFaceVisible(BlockType dst, BlockType neighbor, BlockFace face) const
+    {
+        return ((faceVisibleMask_[face][Blk2Int(dst)] >> Blk2Int(neighbor)) & 1) != 0;
+    }
+
     bool IsSolid(BlockType type) const
     {
         return info_[Blk2Int(type)].isSolid;
@@ -45,5 +55,11 @@ public:
     }
 
 private:
+    void InitFaceVisibleMask(void);
+
     std::vector<BlockInfo> info_;
+
+    //faceVisibleMask_[face][dst]的第neighbor位表示IsFaceVisible(dst, neighbor, face)
+    static_assert(Blk2Int(BlockType::BlockTypeNum) <= 32, "Too many block types for face visibility mask");
+    std::uint32_t faceVisibleMask_[6][Blk2Int(BlockType::BlockTypeNum)];
 };
@@ -0,0 +1,108 @@
+/*================================================================
+Filename: BlockLightBatch.cpp
+Date: 2018.2.14
+Created by AirGuanZ
+================================================================*/
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define BLOCK_LIGHT_BATCH_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define BLOCK_LIGHT_BATCH_SSE2
+#endif
+
+#include "BlockLightBatch.h"
+
+/*
+向量版本的做法：四位的分量没有对应的指令，所以先把每个BlockLight拆成两半，
+    lo保留第0、2个分量，hi保留第1、3个分量并右移四位，
+    这样每个字节里只有一个分量，可以直接用按字节的无符号max，
+    算完再拼回去
+*/
+
+#if defined(BLOCK_LIGHT_BATCH_AVX2)
+
+namespace
+{
+    constexpr size_t BATCH_WIDTH = 16;
+
+    inline __m256i Load(const BlockLight *p)
+    {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    }
+
+    inline void Store(BlockLight *p, __m256i v)
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+    }
+
+    inline __m256i Lo(__m256i v)
+    {
+        return _mm256_and_si256(v, _mm256_set1_epi8(0x0F));
+    }
+
+    inline __m256i Hi(__m256i v)
+    {
+        return _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0F));
+    }
+
+    inline __m256i Merge(__m256i lo, __m256i hi)
+    {
+        return _mm256_or_si256(lo, _mm256_slli_epi16(hi, 4));
+    }
+
+    inline __m256i MaxV(__m256i a, __m256i b)
+    {
+        return Merge(_mm256_max_epu8(Lo(a), Lo(b)), _mm256_max_epu8(Hi(a), Hi(b)));
+    }
+}
+
+#elif defined(BLOCK_LIGHT_BATCH_SSE2)
+
+namespace
+{
+    constexpr size_t BATCH_WIDTH = 8;
+
+    inline __m128i Load(const BlockLight *p)
+    {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    }
+
+    inline void Store(BlockLight *p, __m128i v)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+    }
+
+    inline __m128i Lo(__m128i v)
+    {
+        return _mm_and_si128(v, _mm_set1_epi8(0x0F));
+    }
+
+    inline __m128i Hi(__m128i v)
+    {
+        return _mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0F));
+    }
+
+    inline __m128i Merge(__m128i lo, __m128i hi)
+    {
+        return _mm_or_si128(lo, _mm_slli_epi16(hi, 4));
+    }
+
+    inline __m128i MaxV(__m128i a, __m128i b)
+    {
+        return Merge(_mm_max_epu8(Lo(a), Lo(b)), _mm_max_epu8(Hi(a), Hi(b)));
+    }
+}
+
+#endif
+
+void BlockLightMaxBatch(const BlockLight *a, const BlockLight *b, BlockLight *dst, size_t n)
+{
+    size_t i = 0;
+#if defined(BLOCK_LIGHT_BATCH_AVX2) || defined(BLOCK_LIGHT_BATCH_SSE2)
+    for(; i + BATCH_WIDTH <= n; i += BATCH_WIDTH)
+        Store(dst + i, MaxV(Load(a + i), Load(b + i)));
+#endif
+    for(; i != n; ++i)
+        dst[i] = BlockLightMax(a[i], b[i]);
+}
@@ -0,0 +1,21 @@
+/*================================================================
+Filename: BlockLightBatch.h
+Date: 2018.2.14
+Created by AirGuanZ
+================================================================*/
+#pragma once
+
+#include <cstddef>
+
+#include "Block.h"
+
+/*
+对一整段BlockLight数组做光照运算
+    编译时开了AVX2就一次处理16个，否则用SSE2一次处理8个，
+    两者都没有时退化成逐个调用Block.h中的SWAR版本
+    n不需要是向量宽度的倍数，剩下的尾部逐个处理
+    dst可以和a、b重合，但不能部分重叠
+*/
+
+//dst[i] = BlockLightMax(a[i], b[i])
+void BlockLightMaxBatch(const BlockLight *a, const BlockLight *b, BlockLight *dst, size_t n);
@@ -8,243 +8,238 @@ Created by AirGuanZ
 #include <Chunk/BasicRenderer.h>
 #include <Chunk/CarveRenderer.h>
 #include <Chunk/LiquidRenderer.h>
+#include "BlockAO.h"
 #include "BlockInfoManager.h"
 #include "BlockModelBuilder.h"
 
-const BlockModelBuilder *GetBlockModelBuilder(BlockType type)
+namespace
 {
-    static const BlockModelBuilder_Null                       builder_Null;
-    static const BlockModelBuilder_BasicRenderer_Box          builder_BasicRenderer_Box;
-    static const BlockModelBuilder_CarveRenderer_Box          builder_CarveRenderer_Box;
-    static const BlockModelBuilder_CarveRenderer_Cross        builder_CarveRenderer_Cross;
-    static const BlockModelBuilder_TransLiquidRenderer_Liquid builder_TransLiquidRenderer_Liquid;
-    
-    static const BlockModelBuilder * const rt[4][4] =
+    struct BlockModelBuilderKindTable
     {
-        { &builder_Null, &builder_Null,              &builder_Null,                &builder_Null },
-        { &builder_Null, &builder_BasicRenderer_Box, &builder_Null,                &builder_Null },
-        { &builder_Null, &builder_CarveRenderer_Box, &builder_CarveRenderer_Cross, &builder_Null },
-        { &builder_Null, &builder_Null,              &builder_Null,                &builder_TransLiquidRenderer_Liquid }
+        BlockModelBuilderKind kinds[Blk2Int(BlockType::BlockTypeNum)];
+
+        BlockModelBuilderKindTable(void)
+        {
+            using Kind = BlockModelBuilderKind;
+            static const Kind rt[4][4] =
+            {
+                { Kind::Null, Kind::Null,              Kind::Null,                Kind::Null },
+                { Kind::Null, Kind::BasicRenderer_Box, Kind::Null,                Kind::Null },
+                { Kind::Null, Kind::CarveRenderer_Box, Kind::CarveRenderer_Cross, Kind::Null },
+                { Kind::Null, Kind::Null,              Kind::Null,                Kind::TransLiquidRenderer_Liquid }
+            };
+
+            for(int t = 0; t != Blk2Int(BlockType::BlockTypeNum); ++t)
+            {
+                const BlockInfo &info = BlockInfoManager::GetInstance().GetBlockInfo(Int2Blk(t));
+                kinds[t] = rt[static_cast<std::underlying_type_t<BlockRenderer>>(info.renderer)]
+                             [static_cast<std::underlying_type_t<BlockShape>>(info.shape)];
+            }
+        }
     };
-    
-    const BlockInfo &info = BlockInfoManager::GetInstance().GetBlockInfo(type);
-    return rt[static_cast<std::underlying_type_t<BlockRenderer>>(info.renderer)]
-             [static_cast<std::underlying_type_t<BlockShape>>(info.shape)];
 }
 
-void BlockModelBuilder_Null::Build(
-    const Vector3 &posOffset,
-    const Block (&blks)[3][3][3],
-    ChunkSectionModels *models) const
+BlockModelBuilderKind GetBlockModelBuilderKind(BlockType type)
 {
-
+    static const BlockModelBuilderKindTable table;
+    assert(Blk2Int(type) < Blk2Int(BlockType::BlockTypeNum));
+    return table.kinds[Blk2Int(type)];
 }
 
-namespace
+void BuildBlockModel(
+    BlockModelBuilderKind kind,
+    const Vector3 &posOffset,
+    const IntVector3 &local,
+    const BlockNeighbourhood &blks,
+    ChunkSectionModels *models)
 {
-    inline Color BlockAO(BlockLight l0, BlockLight l1, BlockLight l2, BlockLight l3)
+    assert(kind == GetBlockModelBuilderKind(blks(1, 1, 1).type));
+    switch(kind)
     {
-        return Color(0.15f, 0.15f, 0.15f, 0.15f) + 0.85f * 0.25f * (LightToRGBA(l0) + LightToRGBA(l1) +
-                                                                    LightToRGBA(l2) + LightToRGBA(l3));
+    case BlockModelBuilderKind::BasicRenderer_Box:
+        BlockModelBuilder_BasicRenderer_Box::Build(local, blks, models);
+        break;
+    case BlockModelBuilderKind::CarveRenderer_Box:
+        BlockModelBuilder_CarveRenderer_Box::Build(posOffset, blks, models);
+        break;
+    case BlockModelBuilderKind::CarveRenderer_Cross:
+        BlockModelBuilder_CarveRenderer_Cross::Build(posOffset, blks, models);
+        break;
+    case BlockModelBuilderKind::TransLiquidRenderer_Liquid:
+        BlockModelBuilder_TransLiquidRenderer_Liquid::Build(posOffset, blks, models);
+        break;
+    default:
+        break;
     }
 }
 
 constexpr float UV_OFFSET = 0.0005f;
 
 void BlockModelBuilder_BasicRenderer_Box::Build(
-    const Vector3 &posOffset,
-    const Block(&blks)[3][3][3],
-    ChunkSectionModels *models) const
+    const IntVector3 &local,
+    const BlockNeighbourhood &blks,
+    ChunkSectionModels *models)
 {
     assert(models != nullptr);
 
-    const Block &blk = blks[1][1][1],
-                &pX  = blks[2][1][1],
-                &nX  = blks[0][1][1],
-                &pY  = blks[1][2][1],
-                &nY  = blks[1][0][1],
-                &pZ  = blks[1][1][2],
-                &nZ  = blks[1][1][0];
+    const Block &blk = blks(1, 1, 1),
+                &pX  = blks(2, 1, 1),
+                &nX  = blks(0, 1, 1),
+                &pY  = blks(1, 2, 1),
+                &nY  = blks(1, 0, 1),
+                &pZ  = blks(1, 1, 2),
+                &nZ  = blks(1, 1, 0);
 
     BlockInfoManager &infoMgr = BlockInfoManager::GetInstance();
     const BlockInfo &info = infoMgr.GetBlockInfo(blk.type);
 
-    constexpr float TEX_GRID_SIZE = 1.0f / BASIC_RENDERER_TEXTURE_BLOCK_SIZE;
     BasicModel &model = models->basic[info.basicBoxTexPos[0]];
 
-    auto AddFace = [&](const Vector3 &vtx0, const Vector3 &vtx1,
-                       const Vector3 &vtx2, const Vector3 &vtx3,
-                       const Color &c0, const Color &c1,
-                       const Color &c2, const Color &c3,
-                       int basicBoxTexPosIdx,
+    auto AddFace = [&](const IntVector3 &vtx0, const IntVector3 &vtx1,
+                       const IntVector3 &vtx2, const IntVector3 &vtx3,
+                       std::uint32_t l0, std::uint32_t l1,
+                       std::uint32_t l2, std::uint32_t l3,
+                       BlockFace face,
                        BasicModel &output)
     {
-        float texBaseU = info.basicBoxTexPos[basicBoxTexPosIdx]
-            % BASIC_RENDERER_TEXTURE_BLOCK_SIZE * TEX_GRID_SIZE;
-        float texBaseV = info.basicBoxTexPos[basicBoxTexPosIdx]
-            / BASIC_RENDERER_TEXTURE_BLOCK_SIZE * TEX_GRID_SIZE;
-        UINT16 idxStart = static_cast<UINT16>(output.GetVerticesCount());
-
-        output.AddVertex({ 
-            posOffset + vtx0,
-            { texBaseU + UV_OFFSET, texBaseV + TEX_GRID_SIZE - UV_OFFSET },
-            { c0.R(), c0.G(), c0.B() }, c0.A()
-        });
-        output.AddVertex({
-            posOffset + vtx1,
-            { texBaseU + UV_OFFSET, texBaseV + UV_OFFSET },
-            { c1.R(), c1.G(), c1.B() }, c1.A()
-        });
-        output.AddVertex({
-            posOffset + vtx2,
-            { texBaseU + TEX_GRID_SIZE - UV_OFFSET, texBaseV + UV_OFFSET },
-            { c2.R(), c2.G(), c2.B() }, c2.A()
-        });
-        output.AddVertex({
-            posOffset + vtx3,
-            { texBaseU + TEX_GRID_SIZE - UV_OFFSET, texBaseV + TEX_GRID_SIZE - UV_OFFSET },
-            { c3.R(), c3.G(), c3.B() }, c3.A()
-        });
-
-        output.AddIndex(idxStart);
-        output.AddIndex(idxStart + 1);
-        output.AddIndex(idxStart + 2);
-
-        output.AddIndex(idxStart);
-        output.AddIndex(idxStart + 2);
-        output.AddIndex(idxStart + 3);
+        //纹理坐标以方块为单位，由像素着色器折回纹理所在的那一格，见BasicRenderer::Vertex
+        int texSlot = info.basicBoxTexPos[face + 1];
+        output.AddVertex(PackBasicVertex(local + vtx0, 0, 1, face, texSlot, l0));
+        output.AddVertex(PackBasicVertex(local + vtx1, 0, 0, face, texSlot, l1));
+        output.AddVertex(PackBasicVertex(local + vtx2, 1, 0, face, texSlot, l2));
+        output.AddVertex(PackBasicVertex(local + vtx3, 1, 1, face, texSlot, l3));
     };
 
     //x+
-    if(infoMgr.IsFaceVisible(blk.type, pX.type, { 0, 0, 0 }, { 1, 0, 0 }))
+    if(infoMgr.IsFaceVisible(blk.type, pX.type, PosX))
     {
-        AddFace({ 1.0f, 0.0f, 1.0f }, { 1.0f, 1.0f, 1.0f },
-                { 1.0f, 1.0f, 0.0f }, { 1.0f, 0.0f, 0.0f },
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-					blks[2][0][1].light, blks[2][1][1].light,
-                    blks[2][1][2].light, blks[2][0][2].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-					blks[2][1][1].light, blks[2][2][1].light,
-                    blks[2][2][2].light, blks[2][1][2].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-					blks[2][1][0].light, blks[2][2][0].light,
-                    blks[2][2][1].light, blks[2][1][1].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-					blks[2][0][0].light, blks[2][1][0].light,
-                    blks[2][1][1].light, blks[2][0][1].light),
-                1, model);
+        AddFace({ 1, 0, 1 }, { 1, 1, 1 },
+                { 1, 1, 0 }, { 1, 0, 0 },
+                BlockLightSum(
+					blks(2, 0, 1).light, blks(2, 1, 1).light,
+                    blks(2, 1, 2).light, blks(2, 0, 2).light),
+                BlockLightSum(
+					blks(2, 1, 1).light, blks(2, 2, 1).light,
+                    blks(2, 2, 2).light, blks(2, 1, 2).light),
+                BlockLightSum(
+					blks(2, 1, 0).light, blks(2, 2, 0).light,
+                    blks(2, 2, 1).light, blks(2, 1, 1).light),
+                BlockLightSum(
+					blks(2, 0, 0).light, blks(2, 1, 0).light,
+                    blks(2, 1, 1).light, blks(2, 0, 1).light),
+                PosX, model);
     }
     //x-
-    if(infoMgr.IsFaceVisible(blk.type, nX.type, { 0, 0, 0 }, { -1, 0, 0 }))
+    if(infoMgr.IsFaceVisible(blk.type, nX.type, NegX))
     {
-        AddFace({ 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f },
-                { 0.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 1.0f },
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-					blks[0][0][0].light, blks[0][1][0].light,
-                    blks[0][1][1].light, blks[0][0][1].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-					blks[0][1][0].light, blks[0][2][0].light,
-                    blks[0][2][1].light, blks[0][1][1].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-					blks[0][1][1].light, blks[0][2][1].light,
-                    blks[0][2][2].light, blks[0][1][2].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-					blks[0][0][1].light, blks[0][1][1].light,
-                    blks[0][1][2].light, blks[0][0][2].light),
-                2, model);
+        AddFace({ 0, 0, 0 }, { 0, 1, 0 },
+                { 0, 1, 1 }, { 0, 0, 1 },
+                BlockLightSum(
+					blks(0, 0, 0).light, blks(0, 1, 0).light,
+                    blks(0, 1, 1).light, blks(0, 0, 1).light),
+                BlockLightSum(
+					blks(0, 1, 0).light, blks(0, 2, 0).light,
+                    blks(0, 2, 1).light, blks(0, 1, 1).light),
+                BlockLightSum(
+					blks(0, 1, 1).light, blks(0, 2, 1).light,
+                    blks(0, 2, 2).light, blks(0, 1, 2).light),
+                BlockLightSum(
+					blks(0, 0, 1).light, blks(0, 1, 1).light,
+                    blks(0, 1, 2).light, blks(0, 0, 2).light),
+                NegX, model);
     }
     //y+
-    if(infoMgr.IsFaceVisible(blk.type, pY.type, { 0, 0, 0 }, { 0, 1, 0 }))
+    if(infoMgr.IsFaceVisible(blk.type, pY.type, PosY))
     {
-        AddFace({ 0.0f, 1.0f, 1.0f }, { 0.0f, 1.0f, 0.0f },
-                { 1.0f, 1.0f, 0.0f }, { 1.0f, 1.0f, 1.0f },
-                BlockAO(
-					blks[0][2][2].light, blks[0][2][1].light,
-                    blks[1][2][1].light, blks[1][2][2].light),
-                BlockAO(
-					blks[0][2][1].light, blks[0][2][0].light,
-                    blks[1][2][0].light, blks[1][2][1].light),
-                BlockAO(
-					blks[1][2][1].light, blks[1][2][0].light,
-                    blks[2][2][0].light, blks[2][2][1].light),
-                BlockAO(
-					blks[1][2][2].light, blks[1][2][1].light,
-                    blks[2][2][1].light, blks[2][2][2].light),
-                3, model);
+        AddFace({ 0, 1, 1 }, { 0, 1, 0 },
+                { 1, 1, 0 }, { 1, 1, 1 },
+                BlockLightSum(
+					blks(0, 2, 2).light, blks(0, 2, 1).light,
+                    blks(1, 2, 1).light, blks(1, 2, 2).light),
+                BlockLightSum(
+					blks(0, 2, 1).light, blks(0, 2, 0).light,
+                    blks(1, 2, 0).light, blks(1, 2, 1).light),
+                BlockLightSum(
+					blks(1, 2, 1).light, blks(1, 2, 0).light,
+                    blks(2, 2, 0).light, blks(2, 2, 1).light),
+                BlockLightSum(
+					blks(1, 2, 2).light, blks(1, 2, 1).light,
+                    blks(2, 2, 1).light, blks(2, 2, 2).light),
+                PosY, model);
     }
     //y-
-    if(infoMgr.IsFaceVisible(blk.type, nY.type, { 0, 0, 0 }, { 0, -1, 0 }))
+    if(infoMgr.IsFaceVisible(blk.type, nY.type, NegY))
     {
-        AddFace({ 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f },
-                { 1.0f, 0.0f, 1.0f }, { 1.0f, 0.0f, 0.0f },
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-					blks[0][0][1].light, blks[0][0][0].light,
-                    blks[1][0][0].light, blks[1][0][1].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-					blks[0][0][2].light, blks[0][0][1].light,
-                    blks[1][0][1].light, blks[1][0][2].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-					blks[1][0][2].light, blks[1][0][1].light,
-                    blks[2][0][1].light, blks[2][0][2].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-					blks[1][0][1].light, blks[1][0][0].light,
-                    blks[2][0][0].light, blks[2][0][1].light),
-                4, model);
+        AddFace({ 0, 0, 0 }, { 0, 0, 1 },
+                { 1, 0, 1 }, { 1, 0, 0 },
+                BlockLightSum(
+					blks(0, 0, 1).light, blks(0, 0, 0).light,
+                    blks(1, 0, 0).light, blks(1, 0, 1).light),
+                BlockLightSum(
+					blks(0, 0, 2).light, blks(0, 0, 1).light,
+                    blks(1, 0, 1).light, blks(1, 0, 2).light),
+                BlockLightSum(
+					blks(1, 0, 2).light, blks(1, 0, 1).light,
+                    blks(2, 0, 1).light, blks(2, 0, 2).light),
+                BlockLightSum(
+					blks(1, 0, 1).light, blks(1, 0, 0).light,
+                    blks(2, 0, 0).light, blks(2, 0, 1).light),
+                NegY, model);
     }
     //z+
-    if(infoMgr.IsFaceVisible(blk.type, pZ.type, { 0, 0, 0 }, { 0, 0, 1 }))
+    if(infoMgr.IsFaceVisible(blk.type, pZ.type, PosZ))
     {
-        AddFace({ 0.0f, 0.0f, 1.0f }, { 0.0f, 1.0f, 1.0f },
-                { 1.0f, 1.0f, 1.0f }, { 1.0f, 0.0f, 1.0f },
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-					blks[0][0][2].light, blks[0][1][2].light,
-                    blks[1][1][2].light, blks[1][0][2].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-					blks[0][1][2].light, blks[0][2][2].light,
-                    blks[1][2][2].light, blks[1][1][2].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-					blks[1][1][2].light, blks[1][2][2].light,
-                    blks[2][2][2].light, blks[2][1][2].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-					blks[1][0][2].light, blks[1][1][2].light,
-                    blks[2][1][2].light, blks[2][0][2].light),
-                5, model);
+        AddFace({ 0, 0, 1 }, { 0, 1, 1 },
+                { 1, 1, 1 }, { 1, 0, 1 },
+                BlockLightSum(
+					blks(0, 0, 2).light, blks(0, 1, 2).light,
+                    blks(1, 1, 2).light, blks(1, 0, 2).light),
+                BlockLightSum(
+					blks(0, 1, 2).light, blks(0, 2, 2).light,
+                    blks(1, 2, 2).light, blks(1, 1, 2).light),
+                BlockLightSum(
+					blks(1, 1, 2).light, blks(1, 2, 2).light,
+                    blks(2, 2, 2).light, blks(2, 1, 2).light),
+                BlockLightSum(
+					blks(1, 0, 2).light, blks(1, 1, 2).light,
+                    blks(2, 1, 2).light, blks(2, 0, 2).light),
+                PosZ, model);
     }
     //z-
-    if(infoMgr.IsFaceVisible(blk.type, nZ.type, { 0, 0, 0 }, { 0, 0, -1 }))
+    if(infoMgr.IsFaceVisible(blk.type, nZ.type, NegZ))
     {
-        AddFace({ 1.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 0.0f },
-                { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 0.0f },
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-					blks[1][0][0].light, blks[1][1][0].light,
-                    blks[2][1][0].light, blks[2][0][0].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-					blks[1][1][0].light, blks[1][2][0].light,
-                    blks[2][2][0].light, blks[2][1][0].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-					blks[0][1][0].light, blks[0][2][0].light,
-                    blks[1][2][0].light, blks[1][1][0].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-					blks[0][0][0].light, blks[0][1][0].light,
-                    blks[1][1][0].light, blks[1][0][0].light),
-                6, model);
+        AddFace({ 1, 0, 0 }, { 1, 1, 0 },
+                { 0, 1, 0 }, { 0, 0, 0 },
+                BlockLightSum(
+					blks(1, 0, 0).light, blks(1, 1, 0).light,
+                    blks(2, 1, 0).light, blks(2, 0, 0).light),
+                BlockLightSum(
+					blks(1, 1, 0).light, blks(1, 2, 0).light,
+                    blks(2, 2, 0).light, blks(2, 1, 0).light),
+                BlockLightSum(
+					blks(0, 1, 0).light, blks(0, 2, 0).light,
+                    blks(1, 2, 0).light, blks(1, 1, 0).light),
+                BlockLightSum(
+					blks(0, 0, 0).light, blks(0, 1, 0).light,
+                    blks(1, 1, 0).light, blks(1, 0, 0).light),
+                NegZ, model);
     }
 }
 
 void BlockModelBuilder_CarveRenderer_Box::Build(
     const Vector3 &posOffset,
-    const Block(&blks)[3][3][3],
-    ChunkSectionModels *models) const
+    const BlockNeighbourhood &blks,
+    ChunkSectionModels *models)
 {
     assert(models != nullptr);
 
-    const Block &blk = blks[1][1][1],
-                &pX  = blks[2][1][1],
-                &nX  = blks[0][1][1],
-                &pY  = blks[1][2][1],
-                &nY  = blks[1][0][1],
-                &pZ  = blks[1][1][2],
-                &nZ  = blks[1][1][0];
+    const Block &blk = blks(1, 1, 1),
+                &pX  = blks(2, 1, 1),
+                &nX  = blks(0, 1, 1),
+                &pY  = blks(1, 2, 1),
+                &nY  = blks(1, 0, 1),
+                &pZ  = blks(1, 1, 2),
+                &nZ  = blks(1, 1, 0);
 
     BlockInfoManager &infoMgr = BlockInfoManager::GetInstance();
     const BlockInfo &info = infoMgr.GetBlockInfo(blk.type);
@@ -254,8 +249,9 @@ void BlockModelBuilder_CarveRenderer_Box::Build(
 
     auto AddFace = [&](const Vector3 &vtx0, const Vector3 &vtx1,
                        const Vector3 &vtx2, const Vector3 &vtx3,
-                       const Color &c0, const Color &c1,
-                       const Color &c2, const Color &c3,
+                       std::uint32_t l0, std::uint32_t l1,
+                       std::uint32_t l2, std::uint32_t l3,
+                       const float *aoTable,
                        int carveBoxTexPosIdx,
                        CarveModel &output)
     {
@@ -263,168 +259,162 @@ void BlockModelBuilder_CarveRenderer_Box::Build(
             % CARVE_RENDERER_TEXTURE_BLOCK_SIZE * TEX_GRID_SIZE;
         float texBaseV = info.carveBoxTexPos[carveBoxTexPosIdx]
             / CARVE_RENDERER_TEXTURE_BLOCK_SIZE * TEX_GRID_SIZE;
-        UINT16 idxStart = static_cast<UINT16>(output.GetVerticesCount());
+
+        VertexLight c0 = BlockAO(l0, aoTable), c1 = BlockAO(l1, aoTable),
+                    c2 = BlockAO(l2, aoTable), c3 = BlockAO(l3, aoTable);
 
         output.AddVertex({
             posOffset + vtx0,
             { texBaseU + UV_OFFSET, texBaseV + TEX_GRID_SIZE - UV_OFFSET },
-            { c0.R(), c0.G(), c0.B() }, c0.A()
+            c0.lightColor, c0.sunlight
         });
         output.AddVertex({
             posOffset + vtx1,
             { texBaseU + UV_OFFSET, texBaseV + UV_OFFSET },
-            { c1.R(), c1.G(), c1.B() }, c1.A()
+            c1.lightColor, c1.sunlight
         });
         output.AddVertex({
             posOffset + vtx2,
             { texBaseU + TEX_GRID_SIZE - UV_OFFSET, texBaseV + UV_OFFSET },
-            { c2.R(), c2.G(), c2.B() }, c2.A()
+            c2.lightColor, c2.sunlight
         });
         output.AddVertex({
             posOffset + vtx3,
             { texBaseU + TEX_GRID_SIZE - UV_OFFSET, texBaseV + TEX_GRID_SIZE - UV_OFFSET },
-            { c3.R(), c3.G(), c3.B() }, c3.A()
+            c3.lightColor, c3.sunlight
         });
-
-        output.AddIndex(idxStart);
-        output.AddIndex(idxStart + 1);
-        output.AddIndex(idxStart + 2);
-
-        output.AddIndex(idxStart);
-        output.AddIndex(idxStart + 2);
-        output.AddIndex(idxStart + 3);
     };
 
     //x+
-    if(infoMgr.IsFaceVisible(blk.type, pX.type, { 0, 0, 0 }, { 1, 0, 0 }))
+    if(infoMgr.IsFaceVisible(blk.type, pX.type, PosX))
     {
         AddFace({ 1.0f, 0.0f, 1.0f }, { 1.0f, 1.0f, 1.0f },
                 { 1.0f, 1.0f, 0.0f }, { 1.0f, 0.0f, 0.0f },
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[2][0][1].light, blks[2][1][1].light,
-                    blks[2][1][2].light, blks[2][0][2].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[2][1][1].light, blks[2][2][1].light,
-                    blks[2][2][2].light, blks[2][1][2].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[2][1][0].light, blks[2][2][0].light,
-                    blks[2][2][1].light, blks[2][1][1].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[2][0][0].light, blks[2][1][0].light,
-                    blks[2][1][1].light, blks[2][0][1].light),
-                1, model);
+                BlockLightSum(
+                    blks(2, 0, 1).light, blks(2, 1, 1).light,
+                    blks(2, 1, 2).light, blks(2, 0, 2).light),
+                BlockLightSum(
+                    blks(2, 1, 1).light, blks(2, 2, 1).light,
+                    blks(2, 2, 2).light, blks(2, 1, 2).light),
+                BlockLightSum(
+                    blks(2, 1, 0).light, blks(2, 2, 0).light,
+                    blks(2, 2, 1).light, blks(2, 1, 1).light),
+                BlockLightSum(
+                    blks(2, 0, 0).light, blks(2, 1, 0).light,
+                    blks(2, 1, 1).light, blks(2, 0, 1).light),
+                BLOCK_AO_TABLE.side, 1, model);
     }
     //x-
-    if(infoMgr.IsFaceVisible(blk.type, nX.type, { 0, 0, 0 }, { -1, 0, 0 }))
+    if(infoMgr.IsFaceVisible(blk.type, nX.type, NegX))
     {
         AddFace({ 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f },
                 { 0.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 1.0f },
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[0][0][0].light, blks[0][1][0].light,
-                    blks[0][1][1].light, blks[0][0][1].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[0][1][0].light, blks[0][2][0].light,
-                    blks[0][2][1].light, blks[0][1][1].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[0][1][1].light, blks[0][2][1].light,
-                    blks[0][2][2].light, blks[0][1][2].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[0][0][1].light, blks[0][1][1].light,
-                    blks[0][1][2].light, blks[0][0][2].light),
-                2, model);
+                BlockLightSum(
+                    blks(0, 0, 0).light, blks(0, 1, 0).light,
+                    blks(0, 1, 1).light, blks(0, 0, 1).light),
+                BlockLightSum(
+                    blks(0, 1, 0).light, blks(0, 2, 0).light,
+                    blks(0, 2, 1).light, blks(0, 1, 1).light),
+                BlockLightSum(
+                    blks(0, 1, 1).light, blks(0, 2, 1).light,
+                    blks(0, 2, 2).light, blks(0, 1, 2).light),
+                BlockLightSum(
+                    blks(0, 0, 1).light, blks(0, 1, 1).light,
+                    blks(0, 1, 2).light, blks(0, 0, 2).light),
+                BLOCK_AO_TABLE.side, 2, model);
     }
     //y+
-    if(infoMgr.IsFaceVisible(blk.type, pY.type, { 0, 0, 0 }, { 0, 1, 0 }))
+    if(infoMgr.IsFaceVisible(blk.type, pY.type, PosY))
     {
         AddFace({ 0.0f, 1.0f, 1.0f }, { 0.0f, 1.0f, 0.0f },
                 { 1.0f, 1.0f, 0.0f }, { 1.0f, 1.0f, 1.0f },
-                BlockAO(
-                    blks[0][2][2].light, blks[0][2][1].light,
-                    blks[1][2][1].light, blks[1][2][2].light),
-                BlockAO(
-                    blks[0][2][1].light, blks[0][2][0].light,
-                    blks[1][2][0].light, blks[1][2][1].light),
-                BlockAO(
-                    blks[1][2][1].light, blks[1][2][0].light,
-                    blks[2][2][0].light, blks[2][2][1].light),
-                BlockAO(
-                    blks[1][2][2].light, blks[1][2][1].light,
-                    blks[2][2][1].light, blks[2][2][2].light),
-                3, model);
+                BlockLightSum(
+                    blks(0, 2, 2).light, blks(0, 2, 1).light,
+                    blks(1, 2, 1).light, blks(1, 2, 2).light),
+                BlockLightSum(
+                    blks(0, 2, 1).light, blks(0, 2, 0).light,
+                    blks(1, 2, 0).light, blks(1, 2, 1).light),
+                BlockLightSum(
+                    blks(1, 2, 1).light, blks(1, 2, 0).light,
+                    blks(2, 2, 0).light, blks(2, 2, 1).light),
+                BlockLightSum(
+                    blks(1, 2, 2).light, blks(1, 2, 1).light,
+                    blks(2, 2, 1).light, blks(2, 2, 2).light),
+                BLOCK_AO_TABLE.top, 3, model);
     }
     //y-
-    if(infoMgr.IsFaceVisible(blk.type, nY.type, { 0, 0, 0 }, { 0, -1, 0 }))
+    if(infoMgr.IsFaceVisible(blk.type, nY.type, NegY))
     {
         AddFace({ 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f },
                 { 1.0f, 0.0f, 1.0f }, { 1.0f, 0.0f, 0.0f },
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[0][0][1].light, blks[0][0][0].light,
-                    blks[1][0][0].light, blks[1][0][1].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[0][0][2].light, blks[0][0][1].light,
-                    blks[1][0][1].light, blks[1][0][2].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[1][0][2].light, blks[1][0][1].light,
-                    blks[2][0][1].light, blks[2][0][2].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[1][0][1].light, blks[1][0][0].light,
-                    blks[2][0][0].light, blks[2][0][1].light),
-                4, model);
+                BlockLightSum(
+                    blks(0, 0, 1).light, blks(0, 0, 0).light,
+                    blks(1, 0, 0).light, blks(1, 0, 1).light),
+                BlockLightSum(
+                    blks(0, 0, 2).light, blks(0, 0, 1).light,
+                    blks(1, 0, 1).light, blks(1, 0, 2).light),
+                BlockLightSum(
+                    blks(1, 0, 2).light, blks(1, 0, 1).light,
+                    blks(2, 0, 1).light, blks(2, 0, 2).light),
+                BlockLightSum(
+                    blks(1, 0, 1).light, blks(1, 0, 0).light,
+                    blks(2, 0, 0).light, blks(2, 0, 1).light),
+                BLOCK_AO_TABLE.side, 4, model);
     }
     //z+
-    if(infoMgr.IsFaceVisible(blk.type, pZ.type, { 0, 0, 0 }, { 0, 0, 1 }))
+    if(infoMgr.IsFaceVisible(blk.type, pZ.type, PosZ))
     {
         AddFace({ 0.0f, 0.0f, 1.0f }, { 0.0f, 1.0f, 1.0f },
                 { 1.0f, 1.0f, 1.0f }, { 1.0f, 0.0f, 1.0f },
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[0][0][2].light, blks[0][1][2].light,
-                    blks[1][1][2].light, blks[1][0][2].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[0][1][2].light, blks[0][2][2].light,
-                    blks[1][2][2].light, blks[1][1][2].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[1][1][2].light, blks[1][2][2].light,
-                    blks[2][2][2].light, blks[2][1][2].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[1][0][2].light, blks[1][1][2].light,
-                    blks[2][1][2].light, blks[2][0][2].light),
-                5, model);
+                BlockLightSum(
+                    blks(0, 0, 2).light, blks(0, 1, 2).light,
+                    blks(1, 1, 2).light, blks(1, 0, 2).light),
+                BlockLightSum(
+                    blks(0, 1, 2).light, blks(0, 2, 2).light,
+                    blks(1, 2, 2).light, blks(1, 1, 2).light),
+                BlockLightSum(
+                    blks(1, 1, 2).light, blks(1, 2, 2).light,
+                    blks(2, 2, 2).light, blks(2, 1, 2).light),
+                BlockLightSum(
+                    blks(1, 0, 2).light, blks(1, 1, 2).light,
+                    blks(2, 1, 2).light, blks(2, 0, 2).light),
+                BLOCK_AO_TABLE.side, 5, model);
     }
     //z-
-    if(infoMgr.IsFaceVisible(blk.type, nZ.type, { 0, 0, 0 }, { 0, 0, -1 }))
+    if(infoMgr.IsFaceVisible(blk.type, nZ.type, NegZ))
     {
         AddFace({ 1.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 0.0f },
                 { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 0.0f },
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[1][0][0].light, blks[1][1][0].light,
-                    blks[2][1][0].light, blks[2][0][0].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[1][1][0].light, blks[1][2][0].light,
-                    blks[2][2][0].light, blks[2][1][0].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[0][1][0].light, blks[0][2][0].light,
-                    blks[1][2][0].light, blks[1][1][0].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[0][0][0].light, blks[0][1][0].light,
-                    blks[1][1][0].light, blks[1][0][0].light),
-                6, model);
+                BlockLightSum(
+                    blks(1, 0, 0).light, blks(1, 1, 0).light,
+                    blks(2, 1, 0).light, blks(2, 0, 0).light),
+                BlockLightSum(
+                    blks(1, 1, 0).light, blks(1, 2, 0).light,
+                    blks(2, 2, 0).light, blks(2, 1, 0).light),
+                BlockLightSum(
+                    blks(0, 1, 0).light, blks(0, 2, 0).light,
+                    blks(1, 2, 0).light, blks(1, 1, 0).light),
+                BlockLightSum(
+                    blks(0, 0, 0).light, blks(0, 1, 0).light,
+                    blks(1, 1, 0).light, blks(1, 0, 0).light),
+                BLOCK_AO_TABLE.side, 6, model);
     }
 }
 
 void BlockModelBuilder_CarveRenderer_Cross::Build(
     const Vector3 &posOffset,
-    const Block(&blks)[3][3][3],
-    ChunkSectionModels *models) const
+    const BlockNeighbourhood &blks,
+    ChunkSectionModels *models)
 {
     assert(models != nullptr);
 
-    const Block &blk = blks[1][1][1],
-                &pX  = blks[2][1][1],
-                &nX  = blks[0][1][1],
-                &pY  = blks[1][2][1],
-                &nY  = blks[1][0][1],
-                &pZ  = blks[1][1][2],
-                &nZ  = blks[1][1][0];
+    const Block &blk = blks(1, 1, 1),
+                &pX  = blks(2, 1, 1),
+                &nX  = blks(0, 1, 1),
+                &pY  = blks(1, 2, 1),
+                &nY  = blks(1, 0, 1),
+                &pZ  = blks(1, 1, 2),
+                &nZ  = blks(1, 1, 0);
 
     BlockInfoManager &infoMgr = BlockInfoManager::GetInstance();
     const BlockInfo &info = infoMgr.GetBlockInfo(blk.type);
@@ -446,7 +436,6 @@ void BlockModelBuilder_CarveRenderer_Cross::Build(
                 % CARVE_RENDERER_TEXTURE_BLOCK_SIZE * TEX_GRID_SIZE;
             float texBaseV = info.carveBoxTexPos[carveCrossTexPos]
                 / CARVE_RENDERER_TEXTURE_BLOCK_SIZE * TEX_GRID_SIZE;
-            UINT16 idxStart = static_cast<UINT16>(output.GetVerticesCount());
 
             output.AddVertex({
                 posOffset + vtx0,
@@ -468,14 +457,6 @@ void BlockModelBuilder_CarveRenderer_Cross::Build(
                 { texBaseU + TEX_GRID_SIZE - UV_OFFSET, texBaseV + TEX_GRID_SIZE - UV_OFFSET },
                 { rgbs.R(), rgbs.G(), rgbs.B() }, rgbs.A()
             });
-
-            output.AddIndex(idxStart);
-            output.AddIndex(idxStart + 1);
-            output.AddIndex(idxStart + 2);
-
-            output.AddIndex(idxStart);
-            output.AddIndex(idxStart + 2);
-            output.AddIndex(idxStart + 3);
         };
 
         AddFace({ 0.0f, 0.0f, 1.0f }, { 0.0f, 1.0f, 1.0f },
@@ -490,18 +471,18 @@ void BlockModelBuilder_CarveRenderer_Cross::Build(
 
 void BlockModelBuilder_TransLiquidRenderer_Liquid::Build(
     const Vector3 &posOffset,
-    const Block(&blks)[3][3][3],
-    ChunkSectionModels *models) const
+    const BlockNeighbourhood &blks,
+    ChunkSectionModels *models)
 {
     assert(models != nullptr);
 
-    const Block &blk = blks[1][1][1],
-                &pX  = blks[2][1][1],
-                &nX  = blks[0][1][1],
-                &pY  = blks[1][2][1],
-                &nY  = blks[1][0][1],
-                &pZ  = blks[1][1][2],
-                &nZ  = blks[1][1][0];
+    const Block &blk = blks(1, 1, 1),
+                &pX  = blks(2, 1, 1),
+                &nX  = blks(0, 1, 1),
+                &pY  = blks(1, 2, 1),
+                &nY  = blks(1, 0, 1),
+                &pZ  = blks(1, 1, 2),
+                &nZ  = blks(1, 1, 0);
 
     BlockInfoManager &infoMgr = BlockInfoManager::GetInstance();
     const BlockInfo &info = infoMgr.GetBlockInfo(blk.type);
@@ -511,18 +492,19 @@ void BlockModelBuilder_TransLiquidRenderer_Liquid::Build(
 
     Vector3 vtxPosFactor(1.0f, 1.0f, 1.0f);
     if(pY.type != blk.type &&
-       !(blks[2][1][1].type == blk.type && blks[2][2][1].type == blk.type) &&
-       !(blks[0][1][1].type == blk.type && blks[0][2][1].type == blk.type) &&
-       !(blks[1][1][2].type == blk.type && blks[1][2][2].type == blk.type) &&
-       !(blks[1][1][0].type == blk.type && blks[1][2][0].type == blk.type))
+       !(blks(2, 1, 1).type == blk.type && blks(2, 2, 1).type == blk.type) &&
+       !(blks(0, 1, 1).type == blk.type && blks(0, 2, 1).type == blk.type) &&
+       !(blks(1, 1, 2).type == blk.type && blks(1, 2, 2).type == blk.type) &&
+       !(blks(1, 1, 0).type == blk.type && blks(1, 2, 0).type == blk.type))
     {
         vtxPosFactor.y = 0.8f;
     }
 
     auto AddFace = [&](const Vector3 &vtx0, const Vector3 &vtx1,
                        const Vector3 &vtx2, const Vector3 &vtx3,
-                       const Color &c0, const Color &c1,
-                       const Color &c2, const Color &c3,
+                       std::uint32_t l0, std::uint32_t l1,
+                       std::uint32_t l2, std::uint32_t l3,
+                       const float *aoTable,
                        int transliquidTexPosIdx,
                        LiquidModel &output)
     {
@@ -530,150 +512,144 @@ void BlockModelBuilder_TransLiquidRenderer_Liquid::Build(
             % LIQUID_RENDERER_TEXTURE_BLOCK_SIZE * TEX_GRID_SIZE;
         float texBaseV = info.transLiquidTexPos[transliquidTexPosIdx]
             / LIQUID_RENDERER_TEXTURE_BLOCK_SIZE * TEX_GRID_SIZE;
-        UINT16 idxStart = static_cast<UINT16>(output.GetVerticesCount());
+
+        VertexLight c0 = BlockAO(l0, aoTable), c1 = BlockAO(l1, aoTable),
+                    c2 = BlockAO(l2, aoTable), c3 = BlockAO(l3, aoTable);
 
         output.AddVertex({
             posOffset + vtxPosFactor * vtx0,
             { texBaseU + UV_OFFSET, texBaseV + TEX_GRID_SIZE - UV_OFFSET },
-            { c0.R(), c0.G(), c0.B() }, c0.A()
+            c0.lightColor, c0.sunlight
         });
         output.AddVertex({
             posOffset + vtxPosFactor * vtx1,
             { texBaseU + UV_OFFSET, texBaseV + UV_OFFSET },
-            { c1.R(), c1.G(), c1.B() }, c1.A()
+            c1.lightColor, c1.sunlight
         });
         output.AddVertex({
             posOffset + vtxPosFactor * vtx2,
             { texBaseU + TEX_GRID_SIZE - UV_OFFSET, texBaseV + UV_OFFSET },
-            { c2.R(), c2.G(), c2.B() }, c2.A()
+            c2.lightColor, c2.sunlight
         });
         output.AddVertex({
             posOffset + vtxPosFactor * vtx3,
             { texBaseU + TEX_GRID_SIZE - UV_OFFSET, texBaseV + TEX_GRID_SIZE - UV_OFFSET },
-            { c3.R(), c3.G(), c3.B() }, c3.A()
+            c3.lightColor, c3.sunlight
         });
-
-        output.AddIndex(idxStart);
-        output.AddIndex(idxStart + 1);
-        output.AddIndex(idxStart + 2);
-
-        output.AddIndex(idxStart);
-        output.AddIndex(idxStart + 2);
-        output.AddIndex(idxStart + 3);
     };
 
     //x+
-    if(infoMgr.IsFaceVisible(blk.type, pX.type, { 0, 0, 0 }, { 1, 0, 0 }))
+    if(infoMgr.IsFaceVisible(blk.type, pX.type, PosX))
     {
         AddFace({ 1.0f, 0.0f, 1.0f }, { 1.0f, 1.0f, 1.0f },
                 { 1.0f, 1.0f, 0.0f }, { 1.0f, 0.0f, 0.0f },
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[2][0][1].light, blks[2][1][1].light,
-                    blks[2][1][2].light, blks[2][0][2].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[2][1][1].light, blks[2][2][1].light,
-                    blks[2][2][2].light, blks[2][1][2].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[2][1][0].light, blks[2][2][0].light,
-                    blks[2][2][1].light, blks[2][1][1].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[2][0][0].light, blks[2][1][0].light,
-                    blks[2][1][1].light, blks[2][0][1].light),
-                1, model);
+                BlockLightSum(
+                    blks(2, 0, 1).light, blks(2, 1, 1).light,
+                    blks(2, 1, 2).light, blks(2, 0, 2).light),
+                BlockLightSum(
+                    blks(2, 1, 1).light, blks(2, 2, 1).light,
+                    blks(2, 2, 2).light, blks(2, 1, 2).light),
+                BlockLightSum(
+                    blks(2, 1, 0).light, blks(2, 2, 0).light,
+                    blks(2, 2, 1).light, blks(2, 1, 1).light),
+                BlockLightSum(
+                    blks(2, 0, 0).light, blks(2, 1, 0).light,
+                    blks(2, 1, 1).light, blks(2, 0, 1).light),
+                BLOCK_AO_TABLE.side, 1, model);
     }
     //x-
-    if(infoMgr.IsFaceVisible(blk.type, nX.type, { 0, 0, 0 }, { -1, 0, 0 }))
+    if(infoMgr.IsFaceVisible(blk.type, nX.type, NegX))
     {
         AddFace({ 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f },
                 { 0.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 1.0f },
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[0][0][0].light, blks[0][1][0].light,
-                    blks[0][1][1].light, blks[0][0][1].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[0][1][0].light, blks[0][2][0].light,
-                    blks[0][2][1].light, blks[0][1][1].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[0][1][1].light, blks[0][2][1].light,
-                    blks[0][2][2].light, blks[0][1][2].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[0][0][1].light, blks[0][1][1].light,
-                    blks[0][1][2].light, blks[0][0][2].light),
-                2, model);
+                BlockLightSum(
+                    blks(0, 0, 0).light, blks(0, 1, 0).light,
+                    blks(0, 1, 1).light, blks(0, 0, 1).light),
+                BlockLightSum(
+                    blks(0, 1, 0).light, blks(0, 2, 0).light,
+                    blks(0, 2, 1).light, blks(0, 1, 1).light),
+                BlockLightSum(
+                    blks(0, 1, 1).light, blks(0, 2, 1).light,
+                    blks(0, 2, 2).light, blks(0, 1, 2).light),
+                BlockLightSum(
+                    blks(0, 0, 1).light, blks(0, 1, 1).light,
+                    blks(0, 1, 2).light, blks(0, 0, 2).light),
+                BLOCK_AO_TABLE.side, 2, model);
     }
     //y+
-    if(infoMgr.IsFaceVisible(blk.type, pY.type, { 0, 0, 0 }, { 0, 1, 0 }) || pY.type != blk.type)
+    if(infoMgr.IsFaceVisible(blk.type, pY.type, PosY) || pY.type != blk.type)
     {
         AddFace({ 0.0f, 1.0f, 1.0f }, { 0.0f, 1.0f, 0.0f },
                 { 1.0f, 1.0f, 0.0f }, { 1.0f, 1.0f, 1.0f },
-                BlockAO(
-                    blks[0][2][2].light, blks[0][2][1].light,
-                    blks[1][2][1].light, blks[1][2][2].light),
-                BlockAO(
-                    blks[0][2][1].light, blks[0][2][0].light,
-                    blks[1][2][0].light, blks[1][2][1].light),
-                BlockAO(
-                    blks[1][2][1].light, blks[1][2][0].light,
-                    blks[2][2][0].light, blks[2][2][1].light),
-                BlockAO(
-                    blks[1][2][2].light, blks[1][2][1].light,
-                    blks[2][2][1].light, blks[2][2][2].light),
-                3, model);
+                BlockLightSum(
+                    blks(0, 2, 2).light, blks(0, 2, 1).light,
+                    blks(1, 2, 1).light, blks(1, 2, 2).light),
+                BlockLightSum(
+                    blks(0, 2, 1).light, blks(0, 2, 0).light,
+                    blks(1, 2, 0).light, blks(1, 2, 1).light),
+                BlockLightSum(
+                    blks(1, 2, 1).light, blks(1, 2, 0).light,
+                    blks(2, 2, 0).light, blks(2, 2, 1).light),
+                BlockLightSum(
+                    blks(1, 2, 2).light, blks(1, 2, 1).light,
+                    blks(2, 2, 1).light, blks(2, 2, 2).light),
+                BLOCK_AO_TABLE.top, 3, model);
     }
     //y-
-    if(infoMgr.IsFaceVisible(blk.type, nY.type, { 0, 0, 0 }, { 0, -1, 0 }))
+    if(infoMgr.IsFaceVisible(blk.type, nY.type, NegY))
     {
         AddFace({ 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f },
                 { 1.0f, 0.0f, 1.0f }, { 1.0f, 0.0f, 0.0f },
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[0][0][1].light, blks[0][0][0].light,
-                    blks[1][0][0].light, blks[1][0][1].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[0][0][2].light, blks[0][0][1].light,
-                    blks[1][0][1].light, blks[1][0][2].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[1][0][2].light, blks[1][0][1].light,
-                    blks[2][0][1].light, blks[2][0][2].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[1][0][1].light, blks[1][0][0].light,
-                    blks[2][0][0].light, blks[2][0][1].light),
-                4, model);
+                BlockLightSum(
+                    blks(0, 0, 1).light, blks(0, 0, 0).light,
+                    blks(1, 0, 0).light, blks(1, 0, 1).light),
+                BlockLightSum(
+                    blks(0, 0, 2).light, blks(0, 0, 1).light,
+                    blks(1, 0, 1).light, blks(1, 0, 2).light),
+                BlockLightSum(
+                    blks(1, 0, 2).light, blks(1, 0, 1).light,
+                    blks(2, 0, 1).light, blks(2, 0, 2).light),
+                BlockLightSum(
+                    blks(1, 0, 1).light, blks(1, 0, 0).light,
+                    blks(2, 0, 0).light, blks(2, 0, 1).light),
+                BLOCK_AO_TABLE.side, 4, model);
     }
     //z+
-    if(infoMgr.IsFaceVisible(blk.type, pZ.type, { 0, 0, 0 }, { 0, 0, 1 }))
+    if(infoMgr.IsFaceVisible(blk.type, pZ.type, PosZ))
     {
         AddFace({ 0.0f, 0.0f, 1.0f }, { 0.0f, 1.0f, 1.0f },
                 { 1.0f, 1.0f, 1.0f }, { 1.0f, 0.0f, 1.0f },
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[0][0][2].light, blks[0][1][2].light,
-                    blks[1][1][2].light, blks[1][0][2].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[0][1][2].light, blks[0][2][2].light,
-                    blks[1][2][2].light, blks[1][1][2].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[1][1][2].light, blks[1][2][2].light,
-                    blks[2][2][2].light, blks[2][1][2].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[1][0][2].light, blks[1][1][2].light,
-                    blks[2][1][2].light, blks[2][0][2].light),
-                5, model);
+                BlockLightSum(
+                    blks(0, 0, 2).light, blks(0, 1, 2).light,
+                    blks(1, 1, 2).light, blks(1, 0, 2).light),
+                BlockLightSum(
+                    blks(0, 1, 2).light, blks(0, 2, 2).light,
+                    blks(1, 2, 2).light, blks(1, 1, 2).light),
+                BlockLightSum(
+                    blks(1, 1, 2).light, blks(1, 2, 2).light,
+                    blks(2, 2, 2).light, blks(2, 1, 2).light),
+                BlockLightSum(
+                    blks(1, 0, 2).light, blks(1, 1, 2).light,
+                    blks(2, 1, 2).light, blks(2, 0, 2).light),
+                BLOCK_AO_TABLE.side, 5, model);
     }
     //z-
-    if(infoMgr.IsFaceVisible(blk.type, nZ.type, { 0, 0, 0 }, { 0, 0, -1 }))
+    if(infoMgr.IsFaceVisible(blk.type, nZ.type, NegZ))
     {
         AddFace({ 1.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 0.0f },
                 { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 0.0f },
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[1][0][0].light, blks[1][1][0].light,
-                    blks[2][1][0].light, blks[2][0][0].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[1][1][0].light, blks[1][2][0].light,
-                    blks[2][2][0].light, blks[2][1][0].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[0][1][0].light, blks[0][2][0].light,
-                    blks[1][2][0].light, blks[1][1][0].light),
-                BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO * BlockAO(
-                    blks[0][0][0].light, blks[0][1][0].light,
-                    blks[1][1][0].light, blks[1][0][0].light),
-                6, model);
+                BlockLightSum(
+                    blks(1, 0, 0).light, blks(1, 1, 0).light,
+                    blks(2, 1, 0).light, blks(2, 0, 0).light),
+                BlockLightSum(
+                    blks(1, 1, 0).light, blks(1, 2, 0).light,
+                    blks(2, 2, 0).light, blks(2, 1, 0).light),
+                BlockLightSum(
+                    blks(0, 1, 0).light, blks(0, 2, 0).light,
+                    blks(1, 2, 0).light, blks(1, 1, 0).light),
+                BlockLightSum(
+                    blks(0, 0, 0).light, blks(0, 1, 0).light,
+                    blks(1, 1, 0).light, blks(1, 0, 0).light),
+                BLOCK_AO_TABLE.side, 6, model);
     }
 }
@@ -5,62 +5,69 @@ Created by AirGuanZ
 ================================================================*/
 #pragma once
 
-#include <Chunk/Chunk.h>
+#include <cstdint>
 
-constexpr float BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO = 0.93f;
+#include <Chunk/Chunk.h>
+#include <Chunk/ChunkSectionSnapshot.h>
 
-class BlockModelBuilder
+/*
+方块的建模方式，由BlockInfo中的renderer和shape决定
+    每种方块的建模方式预先查好存在一张表里，
+    建模时按方块类型查表，再用switch分派到对应的Build，不再经过虚函数
+*/
+enum class BlockModelBuilderKind : std::uint8_t
 {
-public:
-    virtual void Build(
-        const Vector3 &posOffset,
-        const Block (&blks)[3][3][3],
-        ChunkSectionModels *models) const = 0;
+    Null,
+    BasicRenderer_Box,
+    CarveRenderer_Box,
+    CarveRenderer_Cross,
+    TransLiquidRenderer_Liquid,
 };
 
-const BlockModelBuilder *GetBlockModelBuilder(BlockType type);
+BlockModelBuilderKind GetBlockModelBuilderKind(BlockType type);
 
-class BlockModelBuilder_Null : public BlockModelBuilder
-{
-public:
-    void Build(
-        const Vector3 &posOffset,
-        const Block(&blks)[3][3][3],
-        ChunkSectionModels *models) const;
-};
+//kind应为GetBlockModelBuilderKind(blks(1, 1, 1).type)
+//posOffset是方块的世界坐标，local是方块在section内的局部坐标
+void BuildBlockModel(
+    BlockModelBuilderKind kind,
+    const Vector3 &posOffset,
+    const IntVector3 &local,
+    const BlockNeighbourhood &blks,
+    ChunkSectionModels *models);
 
-class BlockModelBuilder_BasicRenderer_Box : public BlockModelBuilder
+//BasicRenderer的顶点是打包的局部坐标，只需要local
+class BlockModelBuilder_BasicRenderer_Box
 {
 public:
-    void Build(
-        const Vector3 &posOffset,
-        const Block(&blks)[3][3][3],
-        ChunkSectionModels *models) const;
+    static void Build(
+        const IntVector3 &local,
+        const BlockNeighbourhood &blks,
+        ChunkSectionModels *models);
 };
 
-class BlockModelBuilder_CarveRenderer_Box : public BlockModelBuilder
+class BlockModelBuilder_CarveRenderer_Box
 {
 public:
-    void Build(
+    static void Build(
         const Vector3 &posOffset,
-        const Block(&blks)[3][3][3],
-        ChunkSectionModels *models) const;
+        const BlockNeighbourhood &blks,
+        ChunkSectionModels *models);
 };
 
-class BlockModelBuilder_CarveRenderer_Cross : public BlockModelBuilder
+class BlockModelBuilder_CarveRenderer_Cross
 {
 public:
-    void Build(
+    static void Build(
         const Vector3 &posOffset,
-        const Block(&blks)[3][3][3],
-        ChunkSectionModels *models) const;
+        const BlockNeighbourhood &blks,
+        ChunkSectionModels *models);
 };
 
-class BlockModelBuilder_TransLiquidRenderer_Liquid : public BlockModelBuilder
+class BlockModelBuilder_TransLiquidRenderer_Liquid
 {
 public:
-    void Build(
+    static void Build(
         const Vector3 &posOffset,
-        const Block(&blks)[3][3][3],
-        ChunkSectionModels *models) const;
+        const BlockNeighbourhood &blks,
+        ChunkSectionModels *models);
 };
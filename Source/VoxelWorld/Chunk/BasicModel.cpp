@@ -9,6 +9,7 @@ Created by AirGuanZ
 
 #include <Window/Window.h>
 #include "BasicModel.h"
+#include "QuadIndexBuffer.h"
 
 namespace
 {
@@ -32,95 +33,81 @@ namespace
 
         return SUCCEEDED(hr) ? rt : nullptr;
     }
-
-    ID3D11Buffer *CreateIndexBuffer(void *initData, size_t byteSize, bool dynamic)
-    {
-        assert(dynamic || initData);
-
-        D3D11_BUFFER_DESC dc;
-        dc.BindFlags = D3D11_BIND_INDEX_BUFFER;
-        dc.ByteWidth = static_cast<UINT>(byteSize);
-        dc.CPUAccessFlags = dynamic ? D3D11_CPU_ACCESS_WRITE : 0;
-        dc.MiscFlags = 0;
-        dc.StructureByteStride = 0;
-        dc.Usage = dynamic ? D3D11_USAGE_DYNAMIC : D3D11_USAGE_IMMUTABLE;
-
-        D3D11_SUBRESOURCE_DATA data = { initData, 0, 0 };
-
-        ID3D11Buffer *rt = nullptr;
-        HRESULT hr = Window::GetInstance().GetD3DDevice()->CreateBuffer(
-            &dc, initData ? &data : nullptr, &rt);
-
-        return SUCCEEDED(hr) ? rt : nullptr;
-    }
-}
-
-BasicModel::BasicModel(void)
-{
-
-}
-
-BasicModel::~BasicModel(void)
-{
-    Destroy();
 }
 
-bool BasicModel::MakeVertexBuffer(void)
+template<typename VertexType>
+bool SectionModel<VertexType>::MakeVertexBuffer(SectionModel &geometry)
 {
     assert(vtxBufBinding_.startSlot == -1);
 
-    //model
-    if(vertices_.empty())
+    //不管缓冲有没有创建成功，geometry中的顶点都不再需要了
+    struct GeometryRecycler
+    {
+        SectionModel &self;
+        SectionModel &geometry;
+
+        ~GeometryRecycler(void)
+        {
+            if(&geometry == &self)
+            {
+                //clear不会释放容量，CPU上的副本要换成空数组才真正释放
+                std::vector<Vertex>().swap(self.vertices_);
+            }
+            else
+            {
+                RecycleVector(geometry.vertices_);
+            }
+        }
+    } recycler = { *this, geometry };
+
+    const std::vector<Vertex> &vertices = geometry.vertices_;
+
+    //空model是允许的
+    if(vertices.empty())
     {
         vtxBufBinding_.startSlot = 0;
         return true;
     }
 
-    assert(indices_.size() % 3 == 0);
+    assert(vertices.size() % 4 == 0);
     ID3D11Buffer *buf = CreateVertexBuffer(
-        vertices_.data(), vertices_.size() * sizeof(Vertex), false);
+        const_cast<Vertex*>(vertices.data()), vertices.size() * sizeof(Vertex), false);
     if(!buf)
         return false;
 
-    ID3D11Buffer *idxBuf = CreateIndexBuffer(
-        indices_.data(), indices_.size() * sizeof(UINT16), false);
-    if(!idxBuf)
-    {
-        Helper::ReleaseCOMObjects(buf);
-        return false;
-    }
-
+    //下标缓冲是共用的，这里只记下指针，Destroy时不释放
     vtxBufBinding_.startSlot = 0;
-    vtxBufBinding_.idxCount = static_cast<int>(indices_.size());
-    vtxBufBinding_.indices = idxBuf;
-    vtxBufBinding_.indicesFormat = DXGI_FORMAT_R16_UINT;
+    vtxBufBinding_.idxCount = static_cast<int>(QuadIndexBuffer::GetIndexCount(vertices.size()));
+    vtxBufBinding_.indices = QuadIndexBuffer::GetInstance().GetBuffer(
+        vertices.size(), vtxBufBinding_.indicesFormat);
     vtxBufBinding_.bufs.push_back(buf);
     vtxBufBinding_.strides.push_back(sizeof(Vertex));
     vtxBufBinding_.offsets.push_back(0);
 
-    vertices_.clear();
-    indices_.clear();
-
     return true;
 }
 
-void BasicModel::Destroy(void)
+template<typename VertexType>
+void SectionModel<VertexType>::Destroy(void)
 {
-    vertices_.clear();
-    indices_.clear();
+    std::vector<Vertex>().swap(vertices_);
     if(IsAvailable())
     {
-        assert(vtxBufBinding_.bufs.size() == 1 && vtxBufBinding_.bufs[0]);
-        vtxBufBinding_.bufs[0]->Release();
-
-        assert(vtxBufBinding_.indices != nullptr);
-        vtxBufBinding_.indices->Release();
-        vtxBufBinding_.indices = nullptr;
-
-        vtxBufBinding_.startSlot = -1;
-        vtxBufBinding_.idxCount  = -1;
-        vtxBufBinding_.bufs.clear();
-        vtxBufBinding_.strides.clear();
-        vtxBufBinding_.offsets.clear();
+        for(ID3D11Buffer *buf : vtxBufBinding_.bufs)
+        {
+            assert(buf != nullptr);
+            buf->Release();
+        }
     }
+    vtxBufBinding_.indices = nullptr;
+
+    //空model也要复位，回收后还会再次MakeVertexBuffer
+    vtxBufBinding_.startSlot = -1;
+    vtxBufBinding_.idxCount  = -1;
+    vtxBufBinding_.bufs.clear();
+    vtxBufBinding_.strides.clear();
+    vtxBufBinding_.offsets.clear();
 }
+
+template class SectionModel<BasicRenderer::Vertex>;
+template class SectionModel<CarveRenderer::Vertex>;
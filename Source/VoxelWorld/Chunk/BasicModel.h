@@ -5,34 +5,52 @@ Created by AirGuanZ
 ================================================================*/
 #pragma once
 
+#include <algorithm>
 #include <vector>
 
+#include <Utility/Math.h>
 #include <Utility/Uncopiable.h>
 
 #include <Chunk/BasicRenderer.h>
+#include <Chunk/CarveRenderer.h>
+#include <Chunk/LiquidRenderer.h>
 #include "Model.h"
 
-class BasicModel : public Model, public Uncopiable
+/*
+section中使用同一张纹理的模型
+    顶点先存在CPU上，MakeVertexBuffer创建显存中的缓冲后释放CPU上的副本
+    顶点每四个组成一个四边形，下标使用QuadIndexBuffer中共用的缓冲
+    BasicRenderer的顶点是打包的局部坐标，section原点在绘制时由常量缓冲提供，见SectionRenderQueue
+
+建模线程可以把面写进自己的临时模型，再用MakeVertexBuffer(geometry)上传到另一个模型，
+    临时模型清空但保留容量，下次建模时不用再一点点扩容
+*/
+template<typename VertexType>
+class SectionModel : public Model, public Uncopiable
 {
 public:
-    using Renderer = BasicRenderer;
-    using Vertex = typename Renderer::Vertex;
-    using Uniforms = typename Renderer::Uniforms;
+    using Vertex = VertexType;
 
-    BasicModel(void);
-    ~BasicModel(void);
+    SectionModel(void) = default;
+
+    ~SectionModel(void)
+    {
+        Destroy();
+    }
 
     void AddVertex(const Vertex &vertex)
     {
         vertices_.push_back(vertex);
     }
 
-    void AddIndex(UINT16 index)
+    //用geometry中的顶点创建缓冲，失败时返回false
+    //无论成功与否，geometry不是自己时之后被清空但保留容量，是自己时释放CPU上的副本
+    bool MakeVertexBuffer(SectionModel &geometry);
+
+    bool MakeVertexBuffer(void)
     {
-        indices_.push_back(index);
+        return MakeVertexBuffer(*this);
     }
-
-    bool MakeVertexBuffer(void);
     
     void Destroy(void);
 
@@ -41,15 +59,33 @@ public:
         return vertices_.size();
     }
 
-    size_t GetIndicesCount(void) const
+    //顶点占用的字节数，MakeVertexBuffer之后为0
+    size_t GetGeometryBytes(void) const
     {
-        return indices_.size();
+        return vertices_.size() * sizeof(Vertex);
     }
 
 private:
+    //保留容量时的上限：超过这次用量的4倍就收缩到两倍，免得一个特别大的section让线程一直占着大块内存
+    template<typename T>
+    static void RecycleVector(std::vector<T> &vec)
+    {
+        constexpr size_t MIN_KEPT_CAPACITY = 4096;
+        size_t used = vec.size();
+        vec.clear();
+        if(vec.capacity() > MIN_KEPT_CAPACITY && vec.capacity() > 4 * used)
+        {
+            std::vector<T>().swap(vec);
+            vec.reserve((std::max)(2 * used, MIN_KEPT_CAPACITY));
+        }
+    }
+
     std::vector<Vertex> vertices_;
-    std::vector<UINT16> indices_;
 };
 
-using CarveModel = BasicModel;
-using LiquidModel = BasicModel;
+extern template class SectionModel<BasicRenderer::Vertex>;
+extern template class SectionModel<CarveRenderer::Vertex>;
+
+using BasicModel = SectionModel<BasicRenderer::Vertex>;
+using CarveModel = SectionModel<CarveRenderer::Vertex>;
+using LiquidModel = SectionModel<LiquidRenderer::Vertex>;
@@ -61,14 +61,8 @@ bool BasicRenderer::Initialize(std::string &errMsg)
 
     D3D11_INPUT_ELEMENT_DESC inputLayoutDesc[] =
     {
-        { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0,
-            Helper::MemOffset(&Vertex::pos), D3D11_INPUT_PER_VERTEX_DATA, 0 },
-        { "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0,
-            Helper::MemOffset(&Vertex::texCoord), D3D11_INPUT_PER_VERTEX_DATA, 0 },
-        { "LIGHTCOLOR", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0,
-            Helper::MemOffset(&Vertex::lightColor), D3D11_INPUT_PER_VERTEX_DATA, 0 },
-        { "SUNLIGHT", 0, DXGI_FORMAT_R32_FLOAT, 0,
-            Helper::MemOffset(&Vertex::sunlight), D3D11_INPUT_PER_VERTEX_DATA, 0 }
+        { "PACKED", 0, DXGI_FORMAT_R32G32_UINT, 0,
+            Helper::MemOffset(&Vertex::geo), D3D11_INPUT_PER_VERTEX_DATA, 0 }
     };
     inputLayout_ = CreateInputLayout(
         inputLayoutDesc, static_cast<int>(Helper::ArraySize(inputLayoutDesc)),
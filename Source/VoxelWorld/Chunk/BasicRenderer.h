@@ -5,6 +5,8 @@ Created by AirGuanZ
 ================================================================*/
 #pragma once
 
+#include <cassert>
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -23,12 +25,19 @@ public:
     using ShaderType = OWE::Shader<SS_VS, SS_PS>;
     using Uniforms = OWE::ShaderUniforms<SS_VS, SS_PS>;
 
+    /*
+    打包的顶点，8字节，由顶点着色器解开
+        geo:   x 0-4, y 5-9, z 10-14，section内的局部坐标，取值[0, 16]
+               u 15-19, v 20-24，以方块为单位的纹理坐标，取值[0, 16]
+               face 25-27，BlockFace，决定侧面和底面的变暗
+        light: 0-23是顶点周围四个格子SpreadBlockLight之和，24-31是纹理在图集中的格子编号
+    世界坐标是局部坐标加上常量缓冲Section中的section原点，每次绘制前设置，见SectionRenderQueue
+    像素着色器用frac把texCoord折回纹理所在的那一格，这样合并后的面可以重复纹理
+    */
     struct Vertex
     {
-        Vector3 pos;        // POSITION
-        Vector2 texCoord;   // TEXCOORD
-        Vector3 lightColor; // LIGHTCOLOR
-        float   sunlight;   // SUNLIGHT
+        std::uint32_t geo;   // PACKED.x
+        std::uint32_t light; // PACKED.y
     };
 
     BasicRenderer(void);
@@ -47,3 +56,16 @@ private:
     ID3D11InputLayout *inputLayout_;
     ShaderType shader_;
 };
+
+inline BasicRenderer::Vertex PackBasicVertex(const IntVector3 &localPos, int u, int v,
+                                             int face, int texSlot, std::uint32_t lightSum)
+{
+    assert(0 <= localPos.x && localPos.x < 32 && 0 <= localPos.y && localPos.y < 32 &&
+           0 <= localPos.z && localPos.z < 32);
+    assert(0 <= u && u < 32 && 0 <= v && v < 32 && 0 <= face && face < 6);
+    assert(0 <= texSlot && texSlot < 256 && lightSum < (1u << 24));
+    return { static_cast<std::uint32_t>(localPos.x)         | (static_cast<std::uint32_t>(localPos.y) << 5) |
+            (static_cast<std::uint32_t>(localPos.z) << 10) | (static_cast<std::uint32_t>(u) << 15) |
+            (static_cast<std::uint32_t>(v) << 20)          | (static_cast<std::uint32_t>(face) << 25),
+             lightSum | (static_cast<std::uint32_t>(texSlot) << 24) };
+}
@@ -0,0 +1,49 @@
+/*================================================================
+Filename: BlockAccessor.cpp
+Date: 2018.2.11
+Created by AirGuanZ
+================================================================*/
+#include <cstring>
+
+#include "BlockAccessor.h"
+#include "ChunkManager.h"
+
+BlockAccessor::BlockAccessor(ChunkManager *ckMgr, bool nonBlocking)
+    : ckMgr_(ckMgr), nonBlocking_(nonBlocking), centre_(0, 0)
+{
+    assert(ckMgr != nullptr);
+    std::memset(cks_, 0, sizeof(cks_));
+}
+
+BlockAccessor::BlockAccessor(const Chunk *(&cks)[3][3])
+    : ckMgr_(nullptr), nonBlocking_(true), centre_(cks[1][1]->GetPosition())
+{
+    for(int x = 0; x != 3; ++x)
+    {
+        for(int z = 0; z != 3; ++z)
+        {
+            assert(cks[x][z] != nullptr);
+            assert((cks[x][z]->GetPosition() == IntVectorXZ{ centre_.x + x - 1, centre_.z + z - 1 }));
+            cks_[x][z] = const_cast<Chunk*>(cks[x][z]);
+        }
+    }
+}
+
+Chunk *BlockAccessor::Resolve(int ckX, int ckZ)
+{
+    if(!ckMgr_)
+        return nullptr;
+
+    unsigned int dx = static_cast<unsigned int>(ckX - centre_.x + 1);
+    unsigned int dz = static_cast<unsigned int>(ckZ - centre_.z + 1);
+    if(dx >= 3 || dz >= 3)
+    {
+        //以新访问的区块为中心，旧的缓存全部作废
+        centre_ = { ckX, ckZ };
+        std::memset(cks_, 0, sizeof(cks_));
+        dx = dz = 1;
+    }
+
+    return cks_[dx][dz] = nonBlocking_ ? ckMgr_->TryGetChunk(ckX, ckZ)
+                                       : ckMgr_->GetChunk(ckX, ckZ);
+}
@@ -0,0 +1,102 @@
+/*================================================================
+Filename: BlockAccessor.h
+Date: 2018.2.11
+Created by AirGuanZ
+================================================================*/
+#pragma once
+
+#include <cassert>
+
+#include <Utility/Math.h>
+
+#include <Block/Block.h>
+#include "Chunk.h"
+
+class ChunkManager;
+
+/*
+按世界方块坐标读写方块的访问器，缓存一个中心区块及其周围八个区块
+    连续访问的方块通常挨在一起，命中缓存时只需要移位和查表，不用查区块表，也不用做除法
+
+两种构造方式：
+    从ChunkManager构造：缓存未命中时以所访问的区块为新中心重新取区块，取不到的会被同步加载
+        nonBlocking为true时不会同步加载，没加载的区块和窗口外一样处理，同时请求后台优先加载它
+    从const Chunk *(&)[3][3]构造：只能读这九个区块，窗口外视为空气，光照为LIGHT_ALL_MAX
+
+访问器不持有区块，只应作为局部对象在区块不会被卸载的一段时间内使用
+*/
+class BlockAccessor
+{
+public:
+    explicit BlockAccessor(ChunkManager *ckMgr, bool nonBlocking = false);
+    explicit BlockAccessor(const Chunk *(&cks)[3][3]);
+
+    //取得方块所在的区块以及方块在区块内的xz坐标，在窗口外时返回nullptr
+    //从const Chunk *(&)[3][3]构造时不得通过返回值修改区块
+    Chunk *GetChunk(int blkX, int blkZ, int &inX, int &inZ)
+    {
+        int ckX = blkX >> 4, ckZ = blkZ >> 4;
+        inX = blkX & (CHUNK_SECTION_SIZE - 1);
+        inZ = blkZ & (CHUNK_SECTION_SIZE - 1);
+
+        unsigned int dx = static_cast<unsigned int>(ckX - centre_.x + 1);
+        unsigned int dz = static_cast<unsigned int>(ckZ - centre_.z + 1);
+        if(dx < 3 && dz < 3 && cks_[dx][dz])
+            return cks_[dx][dz];
+        return Resolve(ckX, ckZ);
+    }
+
+    Block GetBlock(int blkX, int blkY, int blkZ)
+    {
+        int inX, inZ;
+        Chunk *ck;
+        if(blkY < 0 || blkY >= CHUNK_MAX_HEIGHT || !(ck = GetChunk(blkX, blkZ, inX, inZ)))
+            return { BlockType::Air, LIGHT_ALL_MAX };
+        return ck->GetBlock(inX, blkY, inZ);
+    }
+
+    BlockType GetBlockType(int blkX, int blkY, int blkZ)
+    {
+        int inX, inZ;
+        Chunk *ck;
+        if(blkY < 0 || blkY >= CHUNK_MAX_HEIGHT || !(ck = GetChunk(blkX, blkZ, inX, inZ)))
+            return BlockType::Air;
+        return ck->GetBlockType(inX, blkY, inZ);
+    }
+
+    BlockLight GetBlockLight(int blkX, int blkY, int blkZ)
+    {
+        int inX, inZ;
+        Chunk *ck;
+        if(blkY < 0 || blkY >= CHUNK_MAX_HEIGHT || !(ck = GetChunk(blkX, blkZ, inX, inZ)))
+            return LIGHT_ALL_MAX;
+        return ck->GetBlockLight(inX, blkY, inZ);
+    }
+
+    void SetBlockLight(int blkX, int blkY, int blkZ, BlockLight light)
+    {
+        int inX, inZ;
+        Chunk *ck;
+        assert(ckMgr_ != nullptr);
+        if(blkY < 0 || blkY >= CHUNK_MAX_HEIGHT || !(ck = GetChunk(blkX, blkZ, inX, inZ)))
+            return;
+        ck->SetBlockLight(inX, blkY, inZ, light);
+    }
+
+    //窗口外返回0
+    int GetHeight(int blkX, int blkZ)
+    {
+        int inX, inZ;
+        Chunk *ck = GetChunk(blkX, blkZ, inX, inZ);
+        return ck ? ck->GetHeight(inX, inZ) : 0;
+    }
+
+private:
+    //缓存未命中时的慢路径
+    Chunk *Resolve(int ckX, int ckZ);
+
+    ChunkManager *ckMgr_;
+    bool nonBlocking_;
+    IntVectorXZ centre_;
+    Chunk *cks_[3][3];
+};
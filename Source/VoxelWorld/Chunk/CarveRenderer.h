@@ -27,7 +27,14 @@ public:
     using ShaderType = OWE::Shader<SS_VS, SS_PS>;
     using Uniforms = OWE::ShaderUniforms<SS_VS, SS_PS>;
 
-    using Vertex = typename BasicRenderer::Vertex;
+    //CarveRenderer和LiquidRenderer的顶点，texCoord直接是图集中的坐标
+    struct Vertex
+    {
+        Vector3 pos;        // POSITION
+        Vector2 texCoord;   // TEXCOORD
+        Vector3 lightColor; // LIGHTCOLOR
+        float   sunlight;   // SUNLIGHT
+    };
 
     CarveRenderer(void);
     ~CarveRenderer(void);
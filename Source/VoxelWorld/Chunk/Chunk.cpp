@@ -10,6 +10,7 @@ Created by AirGuanZ
 #include <Block/BlockInfoManager.h>
 #include "Chunk.h"
 #include "ChunkManager.h"
+#include "ChunkSectionModelsPool.h"
 
 Chunk::Chunk(ChunkManager *ckMgr, const IntVectorXZ &ckPos)
     : ckMgr_(ckMgr), ckPos_(ckPos)
@@ -20,15 +21,22 @@ Chunk::Chunk(ChunkManager *ckMgr, const IntVectorXZ &ckPos)
 
 Chunk::~Chunk(void)
 {
-    for(ChunkSectionModels *model : models_)
-        Helper::SafeDeleteObjects(model);
+    for(ChunkSectionModels *&model : models_)
+        ChunkSectionModelsPool::GetInstance().Delete(model);
+}
+
+void Chunk::SetModels(int section, ChunkSectionModels *models)
+{
+    assert(0 <= section && section < CHUNK_SECTION_NUM);
+    ChunkSectionModelsPool::GetInstance().Delete(models_[section]);
+    models_[section] = models;
 }
 
 void Chunk::Render(const Camera &cam, ChunkSectionRenderQueue *renderQueue)
 {
     assert(renderQueue != nullptr);
 
-    //ChunkAABB
+    //Chunk的AABB盒
     float xL = static_cast<float>(ChunkXZ_To_BlockXZ(ckPos_.x));
     float zL = static_cast<float>(ChunkXZ_To_BlockXZ(ckPos_.z));
     float xH = xL + CHUNK_SECTION_SIZE, zH = zL + CHUNK_SECTION_SIZE;
@@ -41,7 +49,7 @@ void Chunk::Render(const Camera &cam, ChunkSectionRenderQueue *renderQueue)
             cam.InFrustum(AABB({ xL, yL, zL }, { xH, yL + CHUNK_SECTION_SIZE, zH })))
         {
             for(int b = 0; b != BASIC_RENDERER_TEXTURE_NUM; ++b)
-                renderQueue->basic[b].AddModel(&models->basic[b]);
+                renderQueue->basic[b].AddModel(&models->basic[b], { xL, yL, zL });
             for(int b = 0; b != CARVE_RENDERER_TEXTURE_NUM; ++b)
                 renderQueue->carve[b].AddModel(&models->carve[b]);
             for(int b = 0; b != LIQUID_RENDERER_TEXTURE_NUM; ++b)
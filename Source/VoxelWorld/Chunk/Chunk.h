@@ -14,19 +14,22 @@ Created by AirGuanZ
 #include <Chunk/BasicRenderer.h>
 #include <Chunk/CarveRenderer.h>
 #include <Chunk/LiquidRenderer.h>
+#include <Chunk/PalettedArray.h>
 #include <Chunk/RenderQueue.h>
 
-//2^4޸ĵĻXYZҲҪ޸
+//2^4，这里修改的话XYZ也要修改
 constexpr int CHUNK_SECTION_SIZE = 16;
 
-//2^3޸ĵĻXYZҲҪ޸
+//2^3，这里修改的话XYZ也要修改
 constexpr int CHUNK_SECTION_NUM  = 8;
 
-//2^7޸ĵĻXYZҲҪ޸
+//2^7，这里修改的话XYZ也要修改
 constexpr int CHUNK_MAX_HEIGHT   = CHUNK_SECTION_SIZE * CHUNK_SECTION_NUM;
 
 constexpr int CHUNK_BLOCK_NUM = CHUNK_SECTION_SIZE * CHUNK_SECTION_SIZE * CHUNK_MAX_HEIGHT;
 
+constexpr int CHUNK_SECTION_BLOCK_NUM = CHUNK_SECTION_SIZE * CHUNK_SECTION_SIZE * CHUNK_SECTION_SIZE;
+
 constexpr int BLOCK_POSITION_CONVENTION_POSITIVE_OFFSET = 0x40000000;
 
 inline int BlockXZ_To_ChunkXZ(int blk)
@@ -94,7 +97,7 @@ struct ChunkSectionModels
 
 struct ChunkSectionRenderQueue
 {
-    RenderQueue basic[BASIC_RENDERER_TEXTURE_NUM];
+    SectionRenderQueue basic[BASIC_RENDERER_TEXTURE_NUM];
     RenderQueue carve[CARVE_RENDERER_TEXTURE_NUM];
     RenderQueue liquid[LIQUID_RENDERER_TEXTURE_NUM];
 };
@@ -120,24 +123,37 @@ public:
         return (x << 4) | z;
     }
 
+    //section内的下标，y为section内的相对高度
+    static int SectionXYZ(int x, int y, int z)
+    {
+        assert(0 <= x && x < CHUNK_SECTION_SIZE);
+        assert(0 <= z && z < CHUNK_SECTION_SIZE);
+        assert(0 <= y && y < CHUNK_SECTION_SIZE);
+        return (x << 8) | (z << 4) | y;
+    }
+
     BlockType GetBlockType(int x, int y, int z) const
     {
-        return blocks[XYZ(x, y, z)];
+        assert(0 <= y && y < CHUNK_MAX_HEIGHT);
+        return blocks[y >> 4].Get(SectionXYZ(x, y & 0xF, z));
     }
 
     void SetBlockType(int x, int y, int z, BlockType type)
     {
-        blocks[XYZ(x, y, z)] = type;
+        assert(0 <= y && y < CHUNK_MAX_HEIGHT);
+        blocks[y >> 4].Set(SectionXYZ(x, y & 0xF, z), type);
     }
 
     BlockLight GetBlockLight(int x, int y, int z) const
     {
-        return lights[XYZ(x, y, z)];
+        assert(0 <= y && y < CHUNK_MAX_HEIGHT);
+        return lights[y >> 4].Get(SectionXYZ(x, y & 0xF, z));
     }
 
     void SetBlockLight(int x, int y, int z, BlockLight light)
     {
-        lights[XYZ(x, y, z)] = light;
+        assert(0 <= y && y < CHUNK_MAX_HEIGHT);
+        lights[y >> 4].Set(SectionXYZ(x, y & 0xF, z), light);
     }
 
     int GetHeight(int x, int z) const
@@ -166,12 +182,13 @@ public:
         return ChunkXZ_To_BlockXZ(ckPos_.z);
     }
 
-    using BlockTypeData  = BlockType[CHUNK_BLOCK_NUM];
-    using BlockLightData = BlockLight[CHUNK_BLOCK_NUM];
+    //每个section单独做调色板压缩，大部分section只有寥寥几种方块和光照
+    using BlockTypeSection  = PalettedArray<BlockType, CHUNK_SECTION_BLOCK_NUM>;
+    using BlockLightSection = PalettedArray<BlockLight, CHUNK_SECTION_BLOCK_NUM>;
     using HeightMap = int[CHUNK_SECTION_SIZE * CHUNK_SECTION_SIZE];
 
-    BlockTypeData blocks;
-    BlockLightData lights;
+    BlockTypeSection blocks[CHUNK_SECTION_NUM];
+    BlockLightSection lights[CHUNK_SECTION_NUM];
 
     HeightMap heightMap;
 
@@ -181,24 +198,54 @@ public:
         assert(0 <= z && z < CHUNK_SECTION_SIZE);
         assert(0 <= y && y < CHUNK_MAX_HEIGHT);
 
-        int idx = XYZ(x, y, z);
-        return { blocks[idx], lights[idx] };
+        int section = y >> 4, idx = SectionXYZ(x, y & 0xF, z);
+        return { blocks[section].Get(idx), lights[section].Get(idx) };
     }
 
     void SetBlock(int x, int y, int z, const Block &blk)
     {
-        int idx = XYZ(x, y, z);
-        blocks[idx] = blk.type;
-        lights[idx] = blk.light;
+        assert(0 <= y && y < CHUNK_MAX_HEIGHT);
+        int section = y >> 4, idx = SectionXYZ(x, y & 0xF, z);
+        blocks[section].Set(idx, blk.type);
+        lights[section].Set(idx, blk.light);
+    }
+
+    //section内所有方块类型是否相同
+    bool IsSectionUniform(int section) const
+    {
+        assert(0 <= section && section < CHUNK_SECTION_NUM);
+        return blocks[section].IsUniform();
     }
 
-    void SetModels(int section, ChunkSectionModels *models)
+    //仅在IsSectionUniform(section)为true时有意义
+    BlockType GetSectionUniformType(int section) const
     {
         assert(0 <= section && section < CHUNK_SECTION_NUM);
-        Helper::SafeDeleteObjects(models_[section]);
-        models_[section] = models;
+        return blocks[section].GetUniformValue();
+    }
+
+    //整理各section的调色板，应在一批写入（生成、光照计算）完成后调用
+    void CompactData(void)
+    {
+        for(int section = 0; section != CHUNK_SECTION_NUM; ++section)
+        {
+            blocks[section].Compact();
+            lights[section].Compact();
+        }
     }
 
+    //方块与光照数据的堆内存占用，不含模型
+    size_t GetDataMemoryUsage(void) const
+    {
+        size_t rt = 0;
+        for(int section = 0; section != CHUNK_SECTION_NUM; ++section)
+            rt += blocks[section].GetMemoryUsage() + lights[section].GetMemoryUsage();
+        return rt;
+    }
+
+    //旧模型交还给ChunkSectionModelsPool
+    void SetModels(int section, ChunkSectionModels *models);
+
     ChunkSectionModels *GetModels(int section)
     {
         assert(0 <= section && section < CHUNK_SECTION_NUM);
@@ -216,20 +263,19 @@ private:
     ChunkManager *ckMgr_;
     IntVectorXZ ckPos_;
 
-    //±ʹã[x][y][z]
+    //下标的使用：[x][y][z]
     ChunkSectionModels *models_[CHUNK_SECTION_NUM];
 };
 
 inline void CopyChunkData(Chunk &dst, const Chunk &src)
 {
-    static_assert(std::is_trivially_copyable_v<Chunk::BlockTypeData>,
-        "Chunk::BlockTypeData shall be trivially copiable");
-    static_assert(std::is_trivially_copyable_v<Chunk::BlockLightData>,
-        "Chunk::BlockLightData shall be trivially copiable");
     static_assert(std::is_trivially_copyable_v<Chunk::HeightMap>,
         "Chunk::HeightMap shall be trivially copiable");
 
-    std::memcpy(dst.blocks, src.blocks, sizeof(Chunk::BlockTypeData));
-    std::memcpy(dst.lights, src.lights, sizeof(Chunk::BlockLightData));
+    for(int section = 0; section != CHUNK_SECTION_NUM; ++section)
+    {
+        dst.blocks[section] = src.blocks[section];
+        dst.lights[section] = src.lights[section];
+    }
     std::memcpy(dst.heightMap, src.heightMap, sizeof(Chunk::HeightMap));
 }
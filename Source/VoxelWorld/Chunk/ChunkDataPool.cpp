@@ -7,14 +7,13 @@ Created by AirGuanZ
 #include <cstring>
 #include <type_traits>
 
-#include <Utility/HelperFunctions.h>
-
 #include "ChunkDataPool.h"
 
 ChunkDataPool::ChunkDataPool(size_t maxDataCnt)
-    : maxDataCnt_(maxDataCnt)
+    : maxDataCntPerShard_((maxDataCnt + SHARD_NUM - 1) / SHARD_NUM)
 {
-
+    for(Shard &shard : shards_)
+        shard.map.Reserve(maxDataCntPerShard_ + 1);
 }
 
 ChunkDataPool::~ChunkDataPool(void)
@@ -24,46 +23,41 @@ ChunkDataPool::~ChunkDataPool(void)
 
 void ChunkDataPool::Destroy(void)
 {
-    std::lock_guard<std::mutex> lk(mapMutex_);
-    map_.ForEach([](Chunk *ck) { Helper::SafeDeleteObjects(ck); });
-    map_.Clear();
+    for(Shard &shard : shards_)
+    {
+        std::lock_guard<std::mutex> lk(shard.mapMutex);
+        assert(shard.creating.empty());
+        shard.map.Clear();
+    }
 }
 
-bool ChunkDataPool::GetChunk(Chunk &ck)
+ChunkDataPool::ChunkPtr ChunkDataPool::GetChunk(const IntVectorXZ &pos)
 {
-    IntVectorXZ pos = ck.GetPosition();
-    std::lock_guard<std::mutex> lk(mapMutex_);
-    Chunk *rt = nullptr;
-    if(map_.FindAndErase({ pos.x, pos.z }, rt))
-    {
-        assert(rt != nullptr);
-
-        CopyChunkData(ck, *rt);
-
-        map_.PushFront(pos, rt);
-        return true;
-    }
-    return false;
+    Shard &shard = GetShard(pos);
+    std::lock_guard<std::mutex> lk(shard.mapMutex);
+    ChunkPtr *rt = shard.map.Get(pos);
+    return rt ? *rt : ChunkPtr();
 }
 
-void ChunkDataPool::AddChunk(Chunk *ck)
+void ChunkDataPool::AddChunk(ChunkPtr ck)
 {
     assert(ck != nullptr);
     IntVectorXZ pos = ck->GetPosition();
-    std::lock_guard<std::mutex> lk(mapMutex_);
+    Shard &shard = GetShard(pos);
+    std::lock_guard<std::mutex> lk(shard.mapMutex);
+    AddChunkWithoutLock(shard, pos, ck);
+}
 
-    Chunk *existed = nullptr;
-    if(map_.FindAndErase(pos, existed))
+void ChunkDataPool::AddChunkWithoutLock(Shard &shard, const IntVectorXZ &pos, const ChunkPtr &ck)
+{
+    ChunkPtr *existed = shard.map.Get(pos);
+    if(existed)
     {
-        map_.PushFront(pos, ck);
-        Helper::SafeDeleteObjects(existed);
+        *existed = ck;
         return;
     }
 
-    map_.PushFront(pos, ck);
-    while(map_.Size() > maxDataCnt_)
-    {
-        Helper::SafeDeleteObjects(map_.Back());
-        map_.PopBack();
-    }
+    shard.map.PushFront(pos, ck);
+    while(shard.map.Size() > maxDataCntPerShard_)
+        shard.map.PopBack();
 }
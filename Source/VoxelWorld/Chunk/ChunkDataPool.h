@@ -5,38 +5,122 @@ Created by AirGuanZ
 ================================================================*/
 #pragma once
 
+#include <condition_variable>
+#include <memory>
 #include <mutex>
-#include <unordered_map>
-#include <vector>
+#include <unordered_set>
 
-#include <Utility/LinkedMap.h>
+#include <Utility/LRUMap.h>
 #include <Utility/Uncopiable.h>
 
 #include "Chunk.h"
 
 /*
-LRUݣӴСӦԴҪ
+LRU管理缓存数据，池子大小应该略大于需要加载数据区域的外层
+按区块位置分成若干个分片，每个分片有自己的锁和LRU，各分片容量为总容量的均分
+这样不同的加载线程访问不同区块时基本不会互相阻塞
+
+池子里的区块是只读的，以shared_ptr<const Chunk>交出去，取数据不再拷贝
+被LRU淘汰的区块在所有使用者放手之后才会真正释放
+
+GetOrCreate保证同一位置同时只有一个线程在创建数据，其他线程等它做完直接拿结果
+创建函数里可以再去取别的池子（或同一池子其他位置）的数据，只要这种依赖没有环就不会死锁
 */
 class ChunkDataPool : public Uncopiable
 {
 public:
+    using ChunkPtr = std::shared_ptr<const Chunk>;
+
     ChunkDataPool(size_t maxDataCnt);
     ~ChunkDataPool(void);
 
     void Destroy(void);
 
-    //IMPROVEĿǰݻͼݵ߳
-    //ĳҪݵ߳Լʽ
-    //ҪΪӵͬƣڴôһߣһɻ᲻ḺŻ
-    bool GetChunk(Chunk &ck);
+    //不存在时返回空指针
+    ChunkPtr GetChunk(const IntVectorXZ &pos);
+
+    //creator: Chunk*(void)，返回新创建的区块，池子接管其所有权
+    template<typename FuncType>
+    ChunkPtr GetOrCreate(const IntVectorXZ &pos, FuncType &&creator)
+    {
+        Shard &shard = GetShard(pos);
+        {
+            std::unique_lock<std::mutex> lk(shard.mapMutex);
+            for(;;)
+            {
+                ChunkPtr *rt = shard.map.Get(pos);
+                if(rt)
+                    return *rt;
+                if(shard.creating.insert(pos).second)
+                    break;
+                shard.createdCV.wait(lk);
+            }
+        }
+
+        //creator抛出异常时也要撤销creating中的记录并唤醒等待者，否则它们会一直等下去
+        CreatingGuard guard(shard, pos);
 
-    //add֮洢maxDataCnt
-    //ɾһʹþԶ
-    void AddChunk(Chunk *ck);
+        ChunkPtr ck(creator());
+        assert(ck && ck->GetPosition() == pos);
+
+        {
+            std::lock_guard<std::mutex> lk(shard.mapMutex);
+            AddChunkWithoutLock(shard, pos, ck);
+        }
+
+        return ck;
+    }
+
+    //如果add之后存储的数据数量超过maxDataCnt，
+    //会删除最后一次使用距今最远的数据
+    void AddChunk(ChunkPtr ck);
 
 private:
-    size_t maxDataCnt_;
+    static constexpr int SHARD_NUM = 8;
+
+    struct Shard
+    {
+        std::mutex mapMutex;
+        LRUMap<IntVectorXZ, ChunkPtr, IntVectorXZHasher> map;
+
+        //正在被某个线程创建的位置
+        std::unordered_set<IntVectorXZ, IntVectorXZHasher> creating;
+        std::condition_variable createdCV;
+    };
+
+    //析构时把pos移出creating并通知等待的线程，等待者醒来后要么拿到结果，要么自己接着创建
+    class CreatingGuard : public Uncopiable
+    {
+    public:
+        CreatingGuard(Shard &shard, const IntVectorXZ &pos)
+            : shard_(shard), pos_(pos)
+        {
+
+        }
+
+        ~CreatingGuard(void)
+        {
+            {
+                std::lock_guard<std::mutex> lk(shard_.mapMutex);
+                shard_.creating.erase(pos_);
+            }
+            shard_.createdCV.notify_all();
+        }
+
+    private:
+        Shard &shard_;
+        IntVectorXZ pos_;
+    };
+
+    Shard &GetShard(const IntVectorXZ &pos)
+    {
+        //和LRUMap内部用的散列不同，避免同一分片里的键在表中扎堆
+        return shards_[static_cast<unsigned int>(pos.x * 31 + pos.z) % SHARD_NUM];
+    }
+
+    void AddChunkWithoutLock(Shard &shard, const IntVectorXZ &pos, const ChunkPtr &ck);
+
+    size_t maxDataCntPerShard_;
 
-    std::mutex mapMutex_;
-    LinkedMap<IntVectorXZ, Chunk*> map_;
+    Shard shards_[SHARD_NUM];
 };
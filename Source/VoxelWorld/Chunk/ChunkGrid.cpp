@@ -0,0 +1,87 @@
+/*================================================================
+Filename: ChunkGrid.cpp
+Date: 2018.2.11
+Created by AirGuanZ
+================================================================*/
+#include <Utility/HelperFunctions.h>
+
+#include "ChunkGrid.h"
+
+ChunkGrid::ChunkGrid(int radius)
+    : radius_(radius), shift_(0), centre_(0, 0)
+{
+    assert(radius >= 0);
+    while((1 << shift_) < 2 * radius + 1)
+        ++shift_;
+    mask_ = (1 << shift_) - 1;
+    slots_.resize(size_t(1) << (2 * shift_), nullptr);
+}
+
+ChunkGrid::~ChunkGrid(void)
+{
+    Clear();
+}
+
+void ChunkGrid::Add(Chunk *ck)
+{
+    assert(ck != nullptr);
+    IntVectorXZ pos = ck->GetPosition();
+    assert(InWindow(pos.x, pos.z));
+
+    Chunk *&slot = slots_[Slot(pos.x, pos.z)];
+    assert(slot == nullptr);
+    slot = ck;
+}
+
+void ChunkGrid::SetCentre(int ckX, int ckZ)
+{
+    IntVectorXZ oldCentre = centre_;
+    centre_ = { ckX, ckZ };
+
+    long long dx = static_cast<long long>(ckX) - oldCentre.x;
+    long long dz = static_cast<long long>(ckZ) - oldCentre.z;
+    if(dx == 0 && dz == 0)
+        return;
+
+    //跳得太远，旧窗口和新窗口不相交
+    long long width = 2 * radius_ + 1;
+    if(dx <= -width || dx >= width || dz <= -width || dz >= width)
+    {
+        Clear();
+        return;
+    }
+
+    int oldXL = oldCentre.x - radius_, oldXH = oldCentre.x + radius_;
+    int oldZL = oldCentre.z - radius_, oldZH = oldCentre.z + radius_;
+
+    //移出窗口的列
+    for(int x = oldXL; x <= oldXH; ++x)
+    {
+        if(x >= ckX - radius_ && x <= ckX + radius_)
+            continue;
+        for(int z = oldZL; z <= oldZH; ++z)
+            EraseSlot(x, z);
+    }
+
+    //移出窗口的行
+    for(int z = oldZL; z <= oldZH; ++z)
+    {
+        if(z >= ckZ - radius_ && z <= ckZ + radius_)
+            continue;
+        for(int x = oldXL; x <= oldXH; ++x)
+            EraseSlot(x, z);
+    }
+}
+
+void ChunkGrid::Clear(void)
+{
+    for(Chunk *&ck : slots_)
+        Helper::SafeDeleteObjects(ck);
+}
+
+void ChunkGrid::EraseSlot(int ckX, int ckZ)
+{
+    Chunk *&slot = slots_[Slot(ckX, ckZ)];
+    if(slot && slot->GetPosition() == IntVectorXZ{ ckX, ckZ })
+        Helper::SafeDeleteObjects(slot);
+}
@@ -0,0 +1,81 @@
+/*================================================================
+Filename: ChunkGrid.h
+Date: 2018.2.11
+Created by AirGuanZ
+================================================================*/
+#pragma once
+
+#include <cassert>
+#include <vector>
+
+#include <Utility/Math.h>
+#include <Utility/Uncopiable.h>
+
+#include "Chunk.h"
+
+/*
+以中心区块为圆心、边长为2 * radius + 1的正方形窗口内的区块表
+    底层是一个边长为2的幂的环形二维数组，区块坐标直接取低位作为下标，
+    窗口宽度不超过数组边长，所以窗口内的不同位置不会落到同一格子里
+    每个格子还会核对区块自己的位置，窗口外的查询自然返回nullptr
+
+移动中心时只删除移出窗口的那几行/列，跳得太远就整个清空
+表持有其中的区块，删除即delete
+*/
+class ChunkGrid : public Uncopiable
+{
+public:
+    ChunkGrid(int radius);
+    ~ChunkGrid(void);
+
+    Chunk *Find(int ckX, int ckZ) const
+    {
+        Chunk *ck = slots_[Slot(ckX, ckZ)];
+        return (ck && ck->GetPosition() == IntVectorXZ{ ckX, ckZ }) ? ck : nullptr;
+    }
+
+    bool InWindow(int ckX, int ckZ) const
+    {
+        return InWindow(centre_, ckX, ckZ);
+    }
+
+    //ck必须位于窗口内，且该位置上还没有区块
+    void Add(Chunk *ck);
+
+    //移动窗口中心，并删除所有移出窗口的区块
+    void SetCentre(int ckX, int ckZ);
+
+    void Clear(void);
+
+    template<typename FuncType>
+    void ForEach(FuncType &&func) const
+    {
+        for(Chunk *ck : slots_)
+        {
+            if(ck)
+                func(ck);
+        }
+    }
+
+private:
+    int Slot(int ckX, int ckZ) const
+    {
+        return ((ckX & mask_) << shift_) | (ckZ & mask_);
+    }
+
+    bool InWindow(const IntVectorXZ &centre, int ckX, int ckZ) const
+    {
+        long long dx = static_cast<long long>(ckX) - centre.x;
+        long long dz = static_cast<long long>(ckZ) - centre.z;
+        return -radius_ <= dx && dx <= radius_ && -radius_ <= dz && dz <= radius_;
+    }
+
+    void EraseSlot(int ckX, int ckZ);
+
+    int radius_;
+    int shift_;
+    int mask_;
+    IntVectorXZ centre_;
+
+    std::vector<Chunk*> slots_;
+};
@@ -5,18 +5,30 @@ Created by AirGuanZ
 ================================================================*/
 #include <algorithm>
 #include <cassert>
+#include <cstdlib>
+#include <iterator>
+#include <vector>
 
 #include <Utility/HelperFunctions.h>
 
+#include <Block/BlockLightBatch.h>
+
 #include <Land/LandGenerator_V0.h>
 #include <Land/V1/LandGenerator.h>
 
 #include "ChunkLoader.h"
 #include "ChunkManager.h"
 #include "ChunkModelBuilder.h"
-
-ChunkLoader::ChunkLoader(size_t ckPoolSize)
-    : ckPool_(ckPoolSize), landGen_(4792539)
+#include "ChunkSectionModelsPool.h"
+
+ChunkLoader::ChunkLoader(int loadDistance)
+    : loadDistance_(loadDistance),
+      genPool_((2 * loadDistance + 5) * (2 * loadDistance + 5)),
+      litPool_((2 * loadDistance + 3) * (2 * loadDistance + 3)),
+      running_(false),
+      stageTasks_{ loadDistance + 2, loadDistance + 1, loadDistance },
+      loaderMsgs_((2 * loadDistance + 1) * (2 * loadDistance + 1)),
+      landGen_(4792539)
 {
 
 }
@@ -30,7 +42,7 @@ void ChunkLoader::Initialize(int threadNum)
 {
     assert(threads_.empty());
     if(threadNum <= 0)
-        threadNum = (std::max)(4u, std::thread::hardware_concurrency()) - 2;
+        threadNum = static_cast<int>((std::max)(4u, std::thread::hardware_concurrency())) - 2;
 
     running_ = true;
     while(threadNum-- > 0)
@@ -39,7 +51,12 @@ void ChunkLoader::Initialize(int threadNum)
 
 void ChunkLoader::Destroy(void)
 {
-    running_ = false;
+    {
+        std::lock_guard<std::mutex> lk(taskQueueMutex_);
+        running_ = false;
+    }
+    taskQueueCV_.notify_all();
+
     for(std::thread &th : threads_)
     {
         if(th.joinable())
@@ -47,259 +64,683 @@ void ChunkLoader::Destroy(void)
     }
     threads_.clear();
 
-    loaderTasks_.ForEach([](ChunkLoaderTask *t) { Helper::SafeDeleteObjects(t); });
-    loaderTasks_.Clear();
-
-    ckPool_.Destroy();
+    for(ChunkTaskQueue<ChunkLoaderTask> &tasks : stageTasks_)
+        tasks.Clear();
+    stageEntries_.clear();
+    for(ChunkModelTask &task : modelTasks_)
+        Helper::SafeDeleteObjects(task.snapshot);
+    modelTasks_.clear();
+    for(ChunkLoaderTask *task : urgentTasks_)
+        Helper::SafeDeleteObjects(task);
+    urgentTasks_.clear();
+    urgentPositions_.clear();
+
+    genPool_.Destroy();
+    litPool_.Destroy();
 }
 
-void ChunkLoader::AddTask(ChunkLoaderTask *task)
+void ChunkLoader::SetCentrePosition(int ckX, int ckZ)
 {
-    assert(task != nullptr);
-
     std::lock_guard<std::mutex> lk(taskQueueMutex_);
-    loaderTasks_.PushFront(task->GetPosition(), task);
-}
-
-void ChunkLoader::AddMsg(ChunkLoaderMessage *msg)
-{
-    assert(msg != nullptr);
+    for(ChunkTaskQueue<ChunkLoaderTask> &tasks : stageTasks_)
+        tasks.SetCentre({ ckX, ckZ });
 
-    std::lock_guard<std::mutex> lk(msgQueueMutex_);
-    loaderMsgs_.push(msg);
+    //离开生成范围的位置不会再被用到了，正在执行的要留到它执行完
+    for(auto it = stageEntries_.begin(); it != stageEntries_.end();)
+    {
+        const StageEntry &e = it->second;
+        long long dx = std::llabs(static_cast<long long>(it->first.x) - ckX);
+        long long dz = std::llabs(static_cast<long long>(it->first.z) - ckZ);
+        if((std::max)(dx, dz) > loadDistance_ + 2 &&
+           std::none_of(std::begin(e.running), std::end(e.running), [](bool r) { return r; }))
+            it = stageEntries_.erase(it);
+        else
+            ++it;
+    }
 }
 
-ChunkLoaderMessage *ChunkLoader::FetchMsg(void)
+bool ChunkLoader::AddMsg(const ChunkLoaderMessage &msg)
 {
-    std::lock_guard<std::mutex> lk(msgQueueMutex_);
-
-    if(loaderMsgs_.empty())
-        return nullptr;
-
-    ChunkLoaderMessage *rt = loaderMsgs_.front();
-    loaderMsgs_.pop();
-    return rt;
+    //容量能放下整个加载范围，主线程每帧都会取，一般不会满
+    while(!loaderMsgs_.TryPush(msg))
+    {
+        if(!running_)
+            return false;
+        std::this_thread::yield();
+    }
+    return true;
 }
 
-std::queue<ChunkLoaderMessage*> ChunkLoader::FetchAllMsgs(void)
+bool ChunkLoader::FetchMsg(ChunkLoaderMessage &msg)
 {
-    std::lock_guard<std::mutex> lk(msgQueueMutex_);
-    return std::move(loaderMsgs_);
+    return loaderMsgs_.TryPop(msg);
 }
 
 void ChunkLoader::TaskThreadEntry(void)
 {
-    while(running_)
+    for(;;)
     {
         ChunkLoaderTask *task = nullptr;
+        ChunkModelTask modelTask = { };
+        bool urgent = false;
 
         {
-            std::lock_guard<std::mutex> lk(taskQueueMutex_);
-            if(loaderTasks_.Size())
+            std::unique_lock<std::mutex> lk(taskQueueMutex_);
+            taskQueueCV_.wait(lk, [&] { return !running_ || HasTask(); });
+            if(!running_)
+                return;
+
+            if(!urgentTasks_.empty())
+            {
+                task = urgentTasks_.front();
+                urgentTasks_.pop_front();
+                urgent = true;
+            }
+            else if(!modelTasks_.empty())
             {
-                task = loaderTasks_.Back();
-                loaderTasks_.PopBack();
+                modelTask = modelTasks_.front();
+                modelTasks_.pop_front();
             }
+            else
+                task = PopTask();
         }
 
-        if(task)
+        if(modelTask.snapshot)
         {
-            task->Run(this);
+            ChunkLoaderMessage msg;
+            msg.type = ChunkLoaderMessage::SectionModelBuilt;
+            msg.modelBuilt.x       = modelTask.sectionPos.x;
+            msg.modelBuilt.section = modelTask.sectionPos.y;
+            msg.modelBuilt.z       = modelTask.sectionPos.z;
+            msg.modelBuilt.version = modelTask.version;
+            msg.modelBuilt.models  = SnapshotChunkModelBuilder().Build(*modelTask.snapshot);
+            Helper::SafeDeleteObjects(modelTask.snapshot);
+
+            if(!AddMsg(msg))
+                ChunkSectionModelsPool::GetInstance().Delete(msg.modelBuilt.models);
+            continue;
+        }
+
+        //剩下的任务全都出了范围
+        if(!task)
+            continue;
+
+        task->Run(this);
+
+        //紧急任务不经过流水线的依赖记录，Mesh阶段需要的数据都由GetOrCreate现场准备
+        if(urgent)
+        {
+            {
+                std::lock_guard<std::mutex> lk(taskQueueMutex_);
+                urgentPositions_.erase(task->GetPosition());
+            }
             Helper::SafeDeleteObjects(task);
+            continue;
         }
-        else
-            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+        int newTaskCnt;
+        {
+            std::lock_guard<std::mutex> lk(taskQueueMutex_);
+            newTaskCnt = FinishTask(task);
+        }
+        NotifyLoaders(newTaskCnt);
+
+        Helper::SafeDeleteObjects(task);
     }
 }
 
-ChunkLoaderTask::ChunkLoaderTask(Chunk *ck)
-    : ck_(ck)
+ChunkLoader::StageEntry &ChunkLoader::GetStageEntry(ChunkManager *ckMgr, const IntVectorXZ &pos)
 {
-    assert(ck != nullptr);
+    auto it = stageEntries_.find(pos);
+    if(it != stageEntries_.end())
+        return it->second;
+
+    StageEntry &e = stageEntries_[pos];
+    e.ckMgr = ckMgr;
+    e.reached = -1;
+    std::fill(std::begin(e.wanted), std::end(e.wanted), false);
+    std::fill(std::begin(e.running), std::end(e.running), false);
+    return e;
 }
 
-void ChunkLoaderTask::Run(ChunkLoader *loader)
+bool ChunkLoader::InProgress(const StageEntry &entry, const IntVectorXZ &pos, int stage)
 {
-    assert(loader != nullptr);
-
-    std::vector<IntVector3> lightUpdates;
-    loader->LoadChunkData(ck_);
-
-    ChunkLoaderMessage *msg = new ChunkLoaderMessage;
-    msg->type = ChunkLoaderMessage::ChunkLoaded;
-    msg->ckLoaded = ck_;
-    ck_ = nullptr;
-    loader->AddMsg(msg);
+    return entry.running[stage] || stageTasks_[stage].Exists(pos);
 }
 
-ChunkLoaderTask::~ChunkLoaderTask(void)
+int ChunkLoader::RequestStage(ChunkManager *ckMgr, const IntVectorXZ &pos, int stage)
 {
-    Helper::SafeDeleteObjects(ck_);
+    //unordered_map的元素引用在插入其他元素后仍然有效
+    StageEntry &e = GetStageEntry(ckMgr, pos);
+    if(e.reached >= stage || InProgress(e, pos, stage))
+        return 0;
+    e.wanted[stage] = true;
+
+    int newTaskCnt = 0;
+    if(stage > 0)
+    {
+        for(int dx = -1; dx <= 1; ++dx)
+        {
+            for(int dz = -1; dz <= 1; ++dz)
+                newTaskCnt += RequestStage(ckMgr, { pos.x + dx, pos.z + dz }, stage - 1);
+        }
+    }
+
+    if(TrySchedule(pos, stage))
+        ++newTaskCnt;
+    return newTaskCnt;
 }
 
-namespace
+bool ChunkLoader::TrySchedule(const IntVectorXZ &pos, int stage)
 {
-    inline bool OutOfBound(int x, int y, int z)
+    auto it = stageEntries_.find(pos);
+    if(it == stageEntries_.end())
+        return false;
+    StageEntry &e = it->second;
+    if(!e.wanted[stage] || e.reached >= stage || InProgress(e, pos, stage))
+        return false;
+
+    if(stage > 0)
     {
-        return (x | y | z | (3 * CHUNK_SECTION_SIZE - 1 - x) |
-                            (3 * CHUNK_SECTION_SIZE - 1 - z) |
-                            (CHUNK_MAX_HEIGHT - 1 - y)) < 0;
+        for(int dx = -1; dx <= 1; ++dx)
+        {
+            for(int dz = -1; dz <= 1; ++dz)
+            {
+                auto nIt = stageEntries_.find({ pos.x + dx, pos.z + dz });
+                if(nIt == stageEntries_.end() || nIt->second.reached < stage - 1)
+                    return false;
+            }
+        }
     }
 
-    inline BlockLight GetLight(Chunk *(&cks)[3][3], int x, int y, int z)
+    //超出了这一阶段的范围，不再需要
+    if(!stageTasks_[stage].Push(new ChunkLoaderTask(static_cast<ChunkLoaderStage>(stage), e.ckMgr, pos)))
     {
-        if(OutOfBound(x, y, z))
-            return LIGHT_ALL_MAX;
-        return cks[x / CHUNK_SECTION_SIZE][z / CHUNK_SECTION_SIZE]
-            ->GetBlockLight(x % CHUNK_SECTION_SIZE, y, z % CHUNK_SECTION_SIZE);
+        e.wanted[stage] = false;
+        return false;
     }
+    return true;
+}
 
-    inline int GetHeight(Chunk *(&cks)[3][3], int x, int z)
+ChunkLoaderTask *ChunkLoader::PopTask(void)
+{
+    for(int stage = CHUNK_LOADER_STAGE_NUM - 1; stage >= 0; --stage)
     {
-        if(OutOfBound(x, 0, z))
-            return 0;
-        return cks[x / CHUNK_SECTION_SIZE][z / CHUNK_SECTION_SIZE]
-            ->GetHeight(x % CHUNK_SECTION_SIZE, z % CHUNK_SECTION_SIZE);
+        if(stageTasks_[stage].Empty())
+            continue;
+        ChunkLoaderTask *task = stageTasks_[stage].Pop();
+        if(task)
+        {
+            GetStageEntry(task->GetChunkManager(), task->GetPosition()).running[stage] = true;
+            return task;
+        }
     }
+    return nullptr;
+}
 
-    inline BlockType GetType(Chunk *(&cks)[3][3], int x, int y, int z)
+int ChunkLoader::FinishTask(const ChunkLoaderTask *task)
+{
+    int stage = static_cast<int>(task->GetStage());
+    IntVectorXZ pos = task->GetPosition();
+
+    StageEntry &e = GetStageEntry(task->GetChunkManager(), pos);
+    e.running[stage] = false;
+    e.wanted[stage] = false;
+    if(stage == CHUNK_LOADER_STAGE_NUM - 1)
+        return 0;
+    e.reached = (std::max)(e.reached, stage);
+
+    //周围九个区块的下一阶段可能因此满足了依赖
+    int newTaskCnt = 0;
+    for(int dx = -1; dx <= 1; ++dx)
     {
-        if(OutOfBound(x, y, z))
-            return BlockType::Air;
-        return cks[x / CHUNK_SECTION_SIZE][z / CHUNK_SECTION_SIZE]
-            ->GetBlockType(x % CHUNK_SECTION_SIZE, y, z % CHUNK_SECTION_SIZE);
+        for(int dz = -1; dz <= 1; ++dz)
+        {
+            if(TrySchedule({ pos.x + dx, pos.z + dz }, stage + 1))
+                ++newTaskCnt;
+        }
     }
+    return newTaskCnt;
+}
+
+bool ChunkLoader::HasTask(void) const
+{
+    return !urgentTasks_.empty() || !modelTasks_.empty() || std::any_of(std::begin(stageTasks_), std::end(stageTasks_),
+        [](const ChunkTaskQueue<ChunkLoaderTask> &tasks) { return !tasks.Empty(); });
+}
+
+void ChunkLoader::NotifyLoaders(int newTaskCnt)
+{
+    if(newTaskCnt == 1)
+        taskQueueCV_.notify_one();
+    else if(newTaskCnt > 1)
+        taskQueueCV_.notify_all();
+}
+
+ChunkLoaderStats ChunkLoader::GetStats(void)
+{
+    ChunkLoaderStats rt = { };
+
+    std::lock_guard<std::mutex> lk(taskQueueMutex_);
+    for(int stage = 0; stage != CHUNK_LOADER_STAGE_NUM; ++stage)
+        rt.queued[stage] = stageTasks_[stage].Size();
 
-    inline void SetLight(Chunk *(&cks)[3][3], int x, int y, int z, BlockLight light)
+    for(auto &it : stageEntries_)
     {
-        if(OutOfBound(x, y, z))
-            return;
-        cks[x / CHUNK_SECTION_SIZE][z / CHUNK_SECTION_SIZE]
-            ->SetBlockLight(x % CHUNK_SECTION_SIZE, y, z % CHUNK_SECTION_SIZE, light);
+        const StageEntry &e = it.second;
+        for(int stage = 0; stage != CHUNK_LOADER_STAGE_NUM; ++stage)
+        {
+            if(e.running[stage])
+                ++rt.running[stage];
+            else if(e.wanted[stage] && !stageTasks_[stage].Exists(it.first))
+                ++rt.waiting[stage];
+        }
     }
 
-    void LightProg(Chunk *(&cks)[3][3])
+    return rt;
+}
+
+ChunkLoaderTask::ChunkLoaderTask(ChunkLoaderStage stage, ChunkManager *ckMgr, const IntVectorXZ &pos)
+    : stage_(stage), ckMgr_(ckMgr), pos_(pos)
+{
+    assert(ckMgr != nullptr);
+}
+
+void ChunkLoaderTask::Run(ChunkLoader *loader)
+{
+    assert(loader != nullptr);
+
+    switch(stage_)
+    {
+    case ChunkLoaderStage::Generate:
+        loader->GetGeneratedChunk(ckMgr_, pos_);
+        break;
+    case ChunkLoaderStage::Light:
+        loader->GetLitChunk(ckMgr_, pos_);
+        break;
+    case ChunkLoaderStage::Mesh:
+        {
+            Chunk *ck = new Chunk(ckMgr_, pos_);
+            loader->LoadChunkData(ck);
+
+            ChunkLoaderMessage msg;
+            msg.type = ChunkLoaderMessage::ChunkLoaded;
+            msg.ckLoaded = ck;
+            if(!loader->AddMsg(msg))
+                Helper::SafeDeleteObjects(ck);
+        }
+        break;
+    default:
+        std::abort();
+    }
+}
+
+namespace
+{
+    constexpr int LIGHT_WINDOW_SIZE = 3 * CHUNK_SECTION_SIZE;
+
+    /*
+    光照计算用的暂存区，覆盖三乘三个区块
+        区块本身是池子里共享的只读数据，计算过程中的光照只写在这里，
+        算完后只把中心区块那部分拷出去
+        只有[lo, hi)范围内的列参与计算，范围外和世界上下边界以外的格子都当作不存在
+        每个加载线程一份，反复使用
+
+    计算分两种：
+    1. 单个区块自身的光照（范围只有中心区块），在地形生成后立即进行，结果和区块一起存进genPool_
+        a. 天光：生成器已经把高度图以上的格子设为满天光、以下的设为全黑，
+           只有和高度图以上格子相邻的、高度图以下的格子可能被照亮，
+           即每一列最高方块的正上方，以及比相邻列高出来的那一段侧面，
+           从这些地方开始BFS，光照只会横着流进山洞和悬崖下面
+        b. 发光方块：先用调色板排除不含发光方块的section，
+           再把找到的发光方块作为起点BFS
+    2. 边界交换（范围是整个窗口），九个区块各自的光照都已经算好，
+       缺的只是跨过区块边界的那部分，所以只从窗口内每条区块边界两侧的格子开始BFS
+       任何跨边界的光路在第一次跨边界之前都在一个区块内部，已经包含在那个区块自身的光照里，
+       所以结果和把九个区块当作整体从头计算相同
+    */
+    class LightWindow
     {
-        BlockInfoManager &infoMgr = BlockInfoManager::GetInstance();
-        std::deque<IntVector3> progQueue;
+    public:
+        LightWindow(void)
+            : lights_(LIGHT_WINDOW_SIZE * LIGHT_WINDOW_SIZE * CHUNK_MAX_HEIGHT),
+              infoMgr_(BlockInfoManager::GetInstance())
+        {
+
+        }
 
-        auto DirectionalUpdate = [&](BlockLight cenLight, int ax, int ay, int az) -> void
+        //cks中[lo, hi)范围以外的区块可以为nullptr
+        void Load(const Chunk *(&cks)[3][3], int lo, int hi)
         {
-            BlockLight nX = GetLight(cks, ax, ay, az);
-            BlockLight newNX = BlockLightMax(nX, BlockLightMinus(
-                cenLight, infoMgr.GetBlockInfo(GetType(cks, ax, ay, az)).lightDec));
-            if(newNX != nX)
+            assert(0 <= lo && lo < hi && hi <= LIGHT_WINDOW_SIZE);
+            std::copy(&cks[0][0], &cks[0][0] + 9, &cks_[0][0]);
+            lo_ = lo; hi_ = hi;
+            queue_.clear();
+
+            for(int x = lo; x != hi; ++x)
             {
-                SetLight(cks, ax, ay, az, newNX);
-                if(!OutOfBound(ax, ay, az))
-                    progQueue.push_back({ ax, ay, az });
+                for(int z = lo; z != hi; ++z)
+                {
+                    const Chunk *ck = cks_[x / CHUNK_SECTION_SIZE][z / CHUNK_SECTION_SIZE];
+                    int cx = x % CHUNK_SECTION_SIZE, cz = z % CHUNK_SECTION_SIZE;
+                    BlockLight *column = &lights_[Index(x, 0, z)];
+                    for(int y = 0; y != CHUNK_MAX_HEIGHT; ++y)
+                        column[y] = ck->GetBlockLight(cx, y, cz);
+                }
             }
-        };
+        }
 
-        auto TryAsSource = [&](int x, int y, int z)
+        void StoreCentre(Chunk *ck) const
         {
-            if(!OutOfBound(x, y, z) && GetLight(cks, x, y, z) != LIGHT_ALL_MIN)
+            assert(lo_ <= CHUNK_SECTION_SIZE && 2 * CHUNK_SECTION_SIZE <= hi_);
+            for(int x = 0; x != CHUNK_SECTION_SIZE; ++x)
             {
-                progQueue.push_back({ x, y, z });
-                while(progQueue.size())
+                for(int z = 0; z != CHUNK_SECTION_SIZE; ++z)
                 {
-                    auto [x, y, z] = progQueue.front();
-                    progQueue.pop_front();
+                    const BlockLight *column = &lights_[Index(x + CHUNK_SECTION_SIZE, 0, z + CHUNK_SECTION_SIZE)];
+                    for(int y = 0; y != CHUNK_MAX_HEIGHT; ++y)
+                        ck->SetBlockLight(x, y, z, column[y]);
+                }
+            }
+        }
 
-                    BlockLight cenLight = GetLight(cks, x, y, z);
+        //单个区块自身的天光
+        void SunlightPass(void)
+        {
+            constexpr int SIDE_OFFSETS[4][2] = { { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 } };
+            for(int x = lo_; x != hi_; ++x)
+            {
+                for(int z = lo_; z != hi_; ++z)
+                {
+                    int H = GetHeight(x, z);
+                    if(H + 1 < CHUNK_MAX_HEIGHT)
+                        Spread(Get(x, H + 1, z), x, H, z);
 
-                    DirectionalUpdate(cenLight, x - 1, y, z);
-                    DirectionalUpdate(cenLight, x + 1, y, z);
-                    DirectionalUpdate(cenLight, x, y - 1, z);
-                    DirectionalUpdate(cenLight, x, y + 1, z);
-                    DirectionalUpdate(cenLight, x, y, z - 1);
-                    DirectionalUpdate(cenLight, x, y, z + 1);
+                    for(auto [dx, dz] : SIDE_OFFSETS)
+                    {
+                        int nx = x + dx, nz = z + dz;
+                        if(OutOfBound(nx, 0, nz))
+                            continue;
+                        for(int y = GetHeight(nx, nz) + 1; y <= H; ++y)
+                            Spread(Get(nx, y, nz), x, y, z);
+                    }
                 }
             }
-        };
+            Flood();
+        }
 
-        for(int x = 0; x < 3 * CHUNK_SECTION_SIZE; ++x)
+        //单个区块自身的发光方块
+        void EmissionPass(void)
         {
-            for(int z = 0; z < 3 * CHUNK_SECTION_SIZE; ++z)
+            auto IsGlow = [&](BlockType type) { return infoMgr_.GetBlockInfo(type).isGlow; };
+            for(int ckX = lo_ / CHUNK_SECTION_SIZE; ckX * CHUNK_SECTION_SIZE < hi_; ++ckX)
             {
-                int H = GetHeight(cks, x, z);
-                for(int y = 0; y <= H; ++y)
+                for(int ckZ = lo_ / CHUNK_SECTION_SIZE; ckZ * CHUNK_SECTION_SIZE < hi_; ++ckZ)
                 {
-                    if(infoMgr.GetBlockInfo(GetType(cks, x, y, z)).lightDec < LIGHT_COMPONENT_MAX)
+                    const Chunk *ck = cks_[ckX][ckZ];
+                    for(int section = 0; section != CHUNK_SECTION_NUM; ++section)
                     {
-                        TryAsSource(x - 1, y, z);
-                        TryAsSource(x + 1, y, z);
-                        TryAsSource(x, y - 1, z);
-                        TryAsSource(x, y + 1, z);
-                        TryAsSource(x, y, z - 1);
-                        TryAsSource(x, y, z + 1);
+                        if(!ck->blocks[section].AnyInPalette(IsGlow))
+                            continue;
+
+                        int yBase = ChunkSectionIndex_To_BlockY(section);
+                        for(int x = 0; x != CHUNK_SECTION_SIZE; ++x)
+                        {
+                            for(int z = 0; z != CHUNK_SECTION_SIZE; ++z)
+                            {
+                                for(int y = yBase; y != yBase + CHUNK_SECTION_SIZE; ++y)
+                                {
+                                    const BlockInfo &info = infoMgr_.GetBlockInfo(ck->GetBlockType(x, y, z));
+                                    if(!info.isGlow)
+                                        continue;
+
+                                    int wx = ckX * CHUNK_SECTION_SIZE + x, wz = ckZ * CHUNK_SECTION_SIZE + z;
+                                    BlockLight old = Get(wx, y, wz);
+                                    BlockLight lit = BlockLightMax(old, MakeLight(
+                                        static_cast<std::uint8_t>(info.lightEmission.x),
+                                        static_cast<std::uint8_t>(info.lightEmission.y),
+                                        static_cast<std::uint8_t>(info.lightEmission.z),
+                                        LIGHT_COMPONENT_MIN));
+                                    if(lit != old)
+                                    {
+                                        Set(wx, y, wz, lit);
+                                        queue_.push_back({ wx, y, wz });
+                                    }
+                                }
+                            }
+                        }
                     }
                 }
             }
+            Flood();
+        }
+
+        //窗口内的区块之间交换边界光照
+        void BorderPass(void)
+        {
+            for(int b = lo_ + CHUNK_SECTION_SIZE; b < hi_; b += CHUNK_SECTION_SIZE)
+            {
+                for(int t = lo_; t != hi_; ++t)
+                {
+                    SpreadColumn(b - 1, t, b, t);
+                    SpreadColumn(b, t, b - 1, t);
+                    SpreadColumn(t, b - 1, t, b);
+                    SpreadColumn(t, b, t, b - 1);
+                }
+            }
+            Flood();
+        }
+
+    private:
+        static int Index(int x, int y, int z)
+        {
+            return (x * LIGHT_WINDOW_SIZE + z) * CHUNK_MAX_HEIGHT + y;
+        }
+
+        bool OutOfBound(int x, int y, int z) const
+        {
+            return ((x - lo_) | (z - lo_) | y |
+                    (hi_ - 1 - x) | (hi_ - 1 - z) |
+                    (CHUNK_MAX_HEIGHT - 1 - y)) < 0;
+        }
+
+        BlockLight Get(int x, int y, int z) const
+        {
+            if(OutOfBound(x, y, z))
+                return LIGHT_ALL_MAX;
+            return lights_[Index(x, y, z)];
+        }
+
+        void Set(int x, int y, int z, BlockLight light)
+        {
+            assert(!OutOfBound(x, y, z));
+            lights_[Index(x, y, z)] = light;
+        }
+
+        int GetHeight(int x, int z) const
+        {
+            return cks_[x / CHUNK_SECTION_SIZE][z / CHUNK_SECTION_SIZE]
+                ->GetHeight(x % CHUNK_SECTION_SIZE, z % CHUNK_SECTION_SIZE);
+        }
+
+        BlockType GetType(int x, int y, int z) const
+        {
+            return cks_[x / CHUNK_SECTION_SIZE][z / CHUNK_SECTION_SIZE]
+                ->GetBlockType(x % CHUNK_SECTION_SIZE, y, z % CHUNK_SECTION_SIZE);
+        }
+
+        //srcLight从相邻格子流进(x, y, z)，变亮了就进队列
+        void Spread(BlockLight srcLight, int x, int y, int z)
+        {
+            if(OutOfBound(x, y, z))
+                return;
+            BlockLight old = lights_[Index(x, y, z)];
+            //lightDec至少为1，来源没有任何一个分量比这里亮时不可能变亮，省掉查方块类型
+            if(BlockLightMax(old, srcLight) == old)
+                return;
+
+            BlockLight lit = BlockLightMax(old, BlockLightMinus(
+                srcLight, infoMgr_.GetBlockInfo(GetType(x, y, z)).lightDec));
+            if(lit != old)
+            {
+                lights_[Index(x, y, z)] = lit;
+                queue_.push_back({ x, y, z });
+            }
+        }
+
+        /*
+        把(srcX, srcZ)整列的光照流进相邻的(dstX, dstZ)列
+            边界两侧大部分格子的光照本来就一样，先用BlockLightMaxBatch整列比一遍，
+            只有来源更亮的格子才逐个Spread
+            逐个Spread时重新读来源，之前的Spread让来源变亮的话，它已经在队列里了
+        */
+        void SpreadColumn(int srcX, int srcZ, int dstX, int dstZ)
+        {
+            const BlockLight *src = &lights_[Index(srcX, 0, srcZ)];
+            const BlockLight *dst = &lights_[Index(dstX, 0, dstZ)];
+
+            BlockLight maxLights[CHUNK_MAX_HEIGHT];
+            BlockLightMaxBatch(src, dst, maxLights, CHUNK_MAX_HEIGHT);
+            for(int y = 0; y != CHUNK_MAX_HEIGHT; ++y)
+            {
+                if(maxLights[y] != dst[y])
+                    Spread(src[y], dstX, y, dstZ);
+            }
+        }
+
+        void Flood(void)
+        {
+            for(size_t i = 0; i < queue_.size(); ++i)
+            {
+                auto [x, y, z] = queue_[i];
+                BlockLight cenLight = lights_[Index(x, y, z)];
+
+                Spread(cenLight, x - 1, y, z);
+                Spread(cenLight, x + 1, y, z);
+                Spread(cenLight, x, y - 1, z);
+                Spread(cenLight, x, y + 1, z);
+                Spread(cenLight, x, y, z - 1);
+                Spread(cenLight, x, y, z + 1);
+            }
+            queue_.clear();
         }
+
+        std::vector<BlockLight> lights_;
+        std::vector<IntVector3> queue_;
+
+        const Chunk *cks_[3][3];
+        int lo_ = 0, hi_ = 0;
+
+        BlockInfoManager &infoMgr_;
+    };
+
+    //GetLitChunk会在Load之前调用GetGeneratedChunk，所以两者可以共用一份
+    LightWindow &GetThreadLightWindow(void)
+    {
+        thread_local LightWindow window;
+        return window;
     }
 }
 
-void ChunkLoader::LoadChunkData(Chunk *ck)
+ChunkDataPool::ChunkPtr ChunkLoader::GetGeneratedChunk(ChunkManager *ckMgr, const IntVectorXZ &pos)
 {
-    IntVectorXZ ckPos = ck->GetPosition();
-    Chunk *neis = new Chunk[8]
+    return genPool_.GetOrCreate(pos, [&]() -> Chunk*
     {
-        { ck->GetChunkManager(), { ckPos.x - 1, ckPos.z } },        //0
-        { ck->GetChunkManager(), { ckPos.x + 1, ckPos.z } },        //1
-        { ck->GetChunkManager(), { ckPos.x,     ckPos.z - 1 } },    //2
-        { ck->GetChunkManager(), { ckPos.x,     ckPos.z + 1 } },    //3
-        { ck->GetChunkManager(), { ckPos.x - 1, ckPos.z - 1 } },    //4
-        { ck->GetChunkManager(), { ckPos.x - 1, ckPos.z + 1 } },    //5
-        { ck->GetChunkManager(), { ckPos.x + 1, ckPos.z - 1 } },    //6
-        { ck->GetChunkManager(), { ckPos.x + 1, ckPos.z + 1 } },    //7
-    };
+        Chunk *ck = new Chunk(ckMgr, pos);
+        landGen_.GenerateLand(ck);
+
+        //区块自身的光照只依赖它自己，生成后立即算好，之后不会再变
+        LightWindow &window = GetThreadLightWindow();
+        const Chunk *cks[3][3] = { };
+        cks[1][1] = ck;
+        window.Load(cks, CHUNK_SECTION_SIZE, 2 * CHUNK_SECTION_SIZE);
+        window.SunlightPass();
+        window.EmissionPass();
+        window.StoreCentre(ck);
+
+        ck->CompactData();
+        return ck;
+    });
+}
 
-    for(int i = 0; i != 8; ++i)
+ChunkDataPool::ChunkPtr ChunkLoader::GetLitChunk(ChunkManager *ckMgr, const IntVectorXZ &pos)
+{
+    return litPool_.GetOrCreate(pos, [&]() -> Chunk*
     {
-        Chunk &dst = neis[i];
-        if(!ckPool_.GetChunk(dst))
+        ChunkDataPool::ChunkPtr gens[3][3];
+        const Chunk *cks[3][3];
+        for(int dx = 0; dx != 3; ++dx)
         {
-            landGen_.GenerateLand(&dst);
-
-            Chunk *addedCk = new Chunk(dst.GetChunkManager(), dst.GetPosition());
-            CopyChunkData(*addedCk, dst);
-            ckPool_.AddChunk(addedCk);
+            for(int dz = 0; dz != 3; ++dz)
+            {
+                gens[dx][dz] = GetGeneratedChunk(ckMgr, { pos.x + dx - 1, pos.z + dz - 1 });
+                cks[dx][dz] = gens[dx][dz].get();
+            }
         }
-    }
 
-    if(!ckPool_.GetChunk(*ck))
-    {
-        landGen_.GenerateLand(ck);
+        LightWindow &window = GetThreadLightWindow();
+        window.Load(cks, 0, LIGHT_WINDOW_SIZE);
+        window.BorderPass();
 
-        Chunk *addedCk = new Chunk(ck->GetChunkManager(), ck->GetPosition());
-        CopyChunkData(*addedCk, *ck);
-        ckPool_.AddChunk(addedCk);
-    }
-    
-    Chunk *cks[3][3] =
+        Chunk *ck = new Chunk(ckMgr, pos);
+        CopyChunkData(*ck, *cks[1][1]);
+        window.StoreCentre(ck);
+        ck->CompactData();
+        return ck;
+    });
+}
+
+void ChunkLoader::LoadChunkData(Chunk *ck)
+{
+    IntVectorXZ pos = ck->GetPosition();
+
+    //模型要用到周围区块的光照，所以九个区块都要先算好光照
+    ChunkDataPool::ChunkPtr lits[3][3];
+    const Chunk *cks[3][3];
+    for(int dx = 0; dx != 3; ++dx)
     {
-        { neis + 4, neis + 0, neis + 5 },
-        { neis + 2, ck,       neis + 3 },
-        { neis + 6, neis + 1, neis + 7 }
-    };
+        for(int dz = 0; dz != 3; ++dz)
+        {
+            lits[dx][dz] = GetLitChunk(ck->GetChunkManager(), { pos.x + dx - 1, pos.z + dz - 1 });
+            cks[dx][dz] = lits[dx][dz].get();
+        }
+    }
+
+    CopyChunkData(*ck, *cks[1][1]);
 
-    LightProg(cks);
-    
     for(int section = 0; section != CHUNK_SECTION_NUM; ++section)
         ck->SetModels(section, BackgroundChunkModelBuilder().Build(cks, section));
-
-    delete[] neis;
 }
-
 void ChunkLoader::TryAddLoadingTask(ChunkManager *ckMgr, int x, int z)
 {
     assert(ckMgr != nullptr);
-    std::lock_guard<std::mutex> lk(taskQueueMutex_);
-    ChunkLoaderTask *oldTask = nullptr;
-    if(!loaderTasks_.Exists({ x, z }))
+    int newTaskCnt;
+    {
+        std::lock_guard<std::mutex> lk(taskQueueMutex_);
+        newTaskCnt = RequestStage(ckMgr, { x, z }, static_cast<int>(ChunkLoaderStage::Mesh));
+    }
+    NotifyLoaders(newTaskCnt);
+}
+
+void ChunkLoader::TryAddUrgentLoadingTask(ChunkManager *ckMgr, int x, int z)
+{
+    assert(ckMgr != nullptr);
+    IntVectorXZ pos = { x, z };
+    {
+        std::lock_guard<std::mutex> lk(taskQueueMutex_);
+        if(!urgentPositions_.insert(pos).second)
+            return;
+        urgentTasks_.push_back(new ChunkLoaderTask(ChunkLoaderStage::Mesh, ckMgr, pos));
+    }
+    taskQueueCV_.notify_one();
+}
+
+void ChunkLoader::AddModelTask(const IntVector3 &sectionPos, unsigned int version, ChunkSectionSnapshot *snapshot)
+{
+    assert(snapshot != nullptr);
     {
-        loaderTasks_.PushFront(
-            IntVectorXZ{ x, z }, new ChunkLoaderTask(new Chunk(ckMgr, { x, z })));
+        std::lock_guard<std::mutex> lk(taskQueueMutex_);
+        modelTasks_.push_back({ sectionPos, version, snapshot });
     }
+    taskQueueCV_.notify_one();
 }
@@ -6,118 +6,211 @@ Created by AirGuanZ
 #pragma once
 
 #include <atomic>
+#include <condition_variable>
 #include <deque>
 #include <mutex>
-#include <queue>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
-#include <Utility/LinkedMap.h>
+#include <Utility/MPSCQueue.h>
 
 #include <Land/LandGenerator_V0.h>
 #include <Land/V1/LandGenerator.h>
 #include <Land/V2/LandGenerator_V2.h>
 #include "Chunk.h"
 #include "ChunkDataPool.h"
+#include "ChunkSectionSnapshot.h"
+#include "ChunkTaskQueue.h"
 
 /*
-һ̨Ϊ׶
-    1. ݼ
-    2. Ԥ
+后台加载是一条三个阶段的流水线
+    1. Generate：地形生成并计算区块自身的光照，结果存进genPool_
+    2. Light：和周围八个生成好的区块交换边界光照，结果存进litPool_
+    3. Mesh：以周围九个算好光照的区块为窗口创建模型，做好的区块交给主线程
 
-ݴˣChunkLoaderһļУӦάһ
-Ԥأе鶼Ǽغݡֱ顣
+池子里的区块是共享的只读数据，每个位置在每个池子里只生成一次
+    别的线程正在生成时就等它生成完，等待只会从lit指向gen，不会成环
 
-ӻLRUԹװãṩȡݵĲ
+每个阶段有自己的任务队列，一个区块的某个阶段只有在周围九个区块都完成了前一阶段后才会进队列，
+依赖关系由stageEntries_记录，某个区块完成一个阶段时再检查周围九个区块的下一阶段能否进队列
+    加载线程总是先从靠后的阶段取任务，所以内圈的区块能尽快做出模型，外圈的地形生成排在后面
+    各阶段的任务按到中心的距离排序，范围依次是loadDistance + 2、+ 1、+ 0
 
-LoaderͳӶҪֱ֧̼߳ءݣ߳ҪݵʱҪ
+池子基于LRU策略管理，依赖记录只是调度用的，某个阶段的结果被挤出池子时会在用到时重新计算
+
+Loader和池子都要支持直接在主线程加载、计算数据，这样当主线程立即要求数据的时候不至于要阻塞。
 */
 
 class ChunkLoader;
 
+enum class ChunkLoaderStage
+{
+    Generate = 0,
+    Light    = 1,
+    Mesh     = 2,
+};
+
+constexpr int CHUNK_LOADER_STAGE_NUM = 3;
+
 class ChunkLoaderTask
 {
 public:
-    ChunkLoaderTask(Chunk *ck);
-    ~ChunkLoaderTask(void);
+    ChunkLoaderTask(ChunkLoaderStage stage, ChunkManager *ckMgr, const IntVectorXZ &pos);
 
     void Run(ChunkLoader *loader);
 
-    IntVectorXZ GetPosition(void)
+    ChunkLoaderStage GetStage(void) const
     {
-        return ck_->GetPosition();
+        return stage_;
+    }
+
+    ChunkManager *GetChunkManager(void) const
+    {
+        return ckMgr_;
+    }
+
+    IntVectorXZ GetPosition(void) const
+    {
+        return pos_;
     }
 
 private:
-    Chunk *ck_;
+    ChunkLoaderStage stage_;
+    ChunkManager *ckMgr_;
+    IntVectorXZ pos_;
+};
+
+//各阶段的队列深度，给调试窗口用
+struct ChunkLoaderStats
+{
+    //依赖已满足、在队列里等着执行的任务
+    size_t queued[CHUNK_LOADER_STAGE_NUM];
+    //正在执行的任务
+    size_t running[CHUNK_LOADER_STAGE_NUM];
+    //还在等周围区块完成前一阶段的任务
+    size_t waiting[CHUNK_LOADER_STAGE_NUM];
+};
+
+//方块修改后的模型重建任务，不受加载范围限制，优先于流水线中的任务执行
+struct ChunkModelTask
+{
+    IntVector3 sectionPos;
+    unsigned int version;
+    ChunkSectionSnapshot *snapshot;
 };
 
 struct ChunkLoaderMessage
 {
-    enum { ChunkLoaded } type;
+    enum { ChunkLoaded, SectionModelBuilt } type;
     union
     {
         Chunk *ckLoaded;
+
+        struct
+        {
+            int x, section, z;
+            unsigned int version;
+            ChunkSectionModels *models;
+        } modelBuilt;
     };
 };
 
 class ChunkLoader
 {
 public:
-    ChunkLoader(size_t ckPoolSize);
+    ChunkLoader(int loadDistance);
     ~ChunkLoader(void);
 
+    //threadNum <= 0时按硬件线程数自动决定
     void Initialize(int threadNum = -1);
+    //通知所有加载线程退出并等待它们结束，未执行的任务直接丢弃
     void Destroy(void);
 
-    void AddTask(ChunkLoaderTask *task);
-    void AddMsg(ChunkLoaderMessage *msg);
+    //由加载线程调用，队列满时等主线程取走消息
+    //Loader已经停止运行时放弃，返回false，消息里的数据由调用者处理
+    bool AddMsg(const ChunkLoaderMessage &msg);
 
-    ChunkLoaderMessage *FetchMsg(void);
-    std::queue<ChunkLoaderMessage*> FetchAllMsgs(void);
+    //只能在主线程调用，没有消息时返回false
+    bool FetchMsg(ChunkLoaderMessage &msg);
 
-    template<typename FuncType>
-    void DelTaskIf(FuncType &&func)
-    {
-        std::lock_guard<std::mutex> lk(taskQueueMutex_);
-        decltype(loaderTasks_) newTasks;
-        loaderTasks_.ForEach([&](ChunkLoaderTask *task)
-        {
-            if(func(task))
-                newTasks.PushFront(task->GetPosition(), task);
-            else
-                Helper::SafeDeleteObjects(task);
-        });
-        loaderTasks_ = std::move(newTasks);
-    }
-
-    template<typename FuncType>
-    void Sort(FuncType &&func)
-    {
-        std::lock_guard<std::mutex> lk(taskQueueMutex_);
-        loaderTasks_.Sort(std::forward<FuncType>(func));
-    }
+    //任务按到中心的距离由近到远执行，离开各阶段范围的任务在轮到它时丢弃
+    void SetCentrePosition(int ckX, int ckZ);
 
-    //ݼغ
-    //߳޹
+    //真正的区块数据加载函数，填充ck的数据并创建模型
+    //线程无关
     void LoadChunkData(Chunk *ck);
 
+    //生成好地形、只算了自身光照的区块
+    //线程无关
+    ChunkDataPool::ChunkPtr GetGeneratedChunk(ChunkManager *ckMgr, const IntVectorXZ &pos);
+    //和周围八个区块交换过边界光照的区块
+    //线程无关
+    ChunkDataPool::ChunkPtr GetLitChunk(ChunkManager *ckMgr, const IntVectorXZ &pos);
+
+    //请求在后台加载一个区块，已经在加载中的位置会被忽略
     void TryAddLoadingTask(ChunkManager *ckMgr, int ckX, int ckZ);
 
+    //主线程马上要用但还没加载的区块，优先于其他所有任务执行
+    void TryAddUrgentLoadingTask(ChunkManager *ckMgr, int ckX, int ckZ);
+
+    //以截图重建section模型，完成后发出SectionModelBuilt消息，Loader接管snapshot
+    void AddModelTask(const IntVector3 &sectionPos, unsigned int version, ChunkSectionSnapshot *snapshot);
+
+    ChunkLoaderStats GetStats(void);
+
 private:
+    //某个位置在流水线中的进度
+    struct StageEntry
+    {
+        ChunkManager *ckMgr;
+        //已经完成的最后一个阶段，-1表示还没有生成
+        //Mesh阶段每次都会产生一个新区块，不记在这里
+        int reached;
+        bool wanted[CHUNK_LOADER_STAGE_NUM];
+        bool running[CHUNK_LOADER_STAGE_NUM];
+    };
+
     void TaskThreadEntry(void);
 
+    //以下函数都要在持有taskQueueMutex_时调用
+
+    StageEntry &GetStageEntry(ChunkManager *ckMgr, const IntVectorXZ &pos);
+    bool InProgress(const StageEntry &entry, const IntVectorXZ &pos, int stage);
+    //请求位置pos完成stage阶段，会递归地请求周围九个区块完成前一阶段，返回新进队列的任务数
+    int RequestStage(ChunkManager *ckMgr, const IntVectorXZ &pos, int stage);
+    //依赖满足时把任务放进队列，返回是否放进去了
+    bool TrySchedule(const IntVectorXZ &pos, int stage);
+    //从最靠后的阶段开始取任务
+    ChunkLoaderTask *PopTask(void);
+    //返回因此进队列的任务数
+    int FinishTask(const ChunkLoaderTask *task);
+
+    bool HasTask(void) const;
+    void NotifyLoaders(int newTaskCnt);
+
 private:
-    ChunkDataPool ckPool_;
+    int loadDistance_;
+
+    ChunkDataPool genPool_;
+    ChunkDataPool litPool_;
 
     std::vector<std::thread> threads_;
     std::atomic<bool> running_;
 
-    LinkedMap<IntVectorXZ, ChunkLoaderTask*> loaderTasks_;
-    std::queue<ChunkLoaderMessage*> loaderMsgs_;
+    ChunkTaskQueue<ChunkLoaderTask> stageTasks_[CHUNK_LOADER_STAGE_NUM];
+    std::unordered_map<IntVectorXZ, StageEntry, IntVectorXZHasher> stageEntries_;
+    std::deque<ChunkModelTask> modelTasks_;
+
+    std::deque<ChunkLoaderTask*> urgentTasks_;
+    std::unordered_set<IntVectorXZ, IntVectorXZHasher> urgentPositions_;
+    MPSCQueue<ChunkLoaderMessage> loaderMsgs_;
 
     std::mutex taskQueueMutex_;
-    std::mutex msgQueueMutex_;
+
+    //有新任务或需要退出时通知加载线程，和taskQueueMutex_配合使用
+    std::condition_variable taskQueueCV_;
 
     LandGenerator_V2::LandGenerator landGen_;
 };
@@ -10,9 +10,11 @@ Created by AirGuanZ
 #include <Utility/HelperFunctions.h>
 
 #include <Block/BlockInfoManager.h>
+#include "BlockAccessor.h"
 #include "ChunkLoader.h"
 #include "ChunkManager.h"
 #include "ChunkModelBuilder.h"
+#include "ChunkSectionModelsPool.h"
 
 ChunkManager::ChunkManager(int loadDistance,
                            int renderDistance,
@@ -20,7 +22,10 @@ ChunkManager::ChunkManager(int loadDistance,
     : loadDistance_(loadDistance),
       renderDistance_(renderDistance),
       unloadDistance_(unloadDistance),
-      ckLoader_((loadDistance + 2) * (loadDistance + 2))
+      chunks_(unloadDistance),
+      modelVersion_(0),
+      editDepth_(0),
+      ckLoader_(loadDistance)
 {
     centrePos_.x = (std::numeric_limits<decltype(centrePos_.x)>::min)();
     centrePos_.z = (std::numeric_limits<decltype(centrePos_.z)>::min)();
@@ -41,14 +46,33 @@ void ChunkManager::Destroy(void)
     ckLoader_.Destroy();
     ProcessChunkLoaderMessages();
 
-    for(auto it : chunks_)
+    chunks_.Clear();
+    for(auto it : farChunks_)
         Helper::SafeDeleteObjects(it.second);
-    chunks_.clear();
+    farChunks_.clear();
     modelUpdates_.clear();
+    waitingModelUpdates_.clear();
+
+    pendingModels_.clear();
+    for(ReadyModel &m : readyModels_)
+        ChunkSectionModelsPool::GetInstance().Delete(m.models);
+    readyModels_.clear();
 }
 
 namespace
 {
+    //每帧最多换上去的section模型数
+    constexpr int MODEL_SWAP_BUDGET_PER_FRAME = 16;
+
+    //碰撞检测用的方块包围盒，还没加载的区块当作实心的，免得角色穿进去
+    AABB GetCollisionAABB(BlockAccessor &acc, int blkX, int blkY, int blkZ)
+    {
+        int inX, inZ;
+        if(0 <= blkY && blkY < CHUNK_MAX_HEIGHT && !acc.GetChunk(blkX, blkZ, inX, inZ))
+            return AABB({ 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f });
+        return BlockInfoManager::GetInstance().GetAABB(acc.GetBlockType(blkX, blkY, blkZ));
+    }
+
     inline void UpdateMinDis(float &minDis, BlockFace &face, float newDis, BlockFace newFace)
     {
         if(minDis < newDis)
@@ -59,84 +83,111 @@ namespace
     }
 }
 
-//IMPROVE
-void ChunkManager::RemoveLightSource(int x, int y, int z)
+void ChunkManager::SetBlockType(int blkX, int blkY, int blkZ, BlockType type)
+{
+    if(blkY < 0 || blkY >= CHUNK_MAX_HEIGHT)
+        return;
+
+    //修改还没加载的区块没有意义，加载时它会被重新生成
+    Chunk *ck = TryGetChunk(BlockXZ_To_ChunkXZ(blkX), BlockXZ_To_ChunkXZ(blkZ));
+    if(!ck)
+        return;
+
+    int cx = BlockXZ_To_BlockXZInChunk(blkX);
+    int cz = BlockXZ_To_BlockXZInChunk(blkZ);
+
+    BeginEdit();
+
+    ck->SetBlockType(cx, blkY, cz, type);
+    editedBlocks_.insert(IntVector3{ blkX, blkY, blkZ });
+
+    IntVectorXZ column(blkX, blkZ);
+    auto it = editedColumns_.find(column);
+    if(it == editedColumns_.end())
+        editedColumns_.insert(std::make_pair(column, EditedColumn{ ck->GetHeight(cx, cz), blkY }));
+    else
+        it->second.maxY = (std::max)(it->second.maxY, blkY);
+
+    Commit();
+}
+
+void ChunkManager::BeginEdit(void)
+{
+    ++editDepth_;
+}
+
+void ChunkManager::SetBlocks(const std::vector<BlockEdit> &edits)
 {
-    UpdateLight(x, y, z);
+    BeginEdit();
+    for(const BlockEdit &edit : edits)
+        SetBlockType(edit.pos.x, edit.pos.y, edit.pos.z, edit.type);
+    Commit();
 }
 
-void ChunkManager::UpdateLight(int x, int y, int z)
+void ChunkManager::Commit(void)
 {
-    std::deque<IntVector3> pgQueue = { { x, y, z } };
-    while(pgQueue.size())
+    assert(editDepth_ > 0);
+    if(--editDepth_ > 0)
+        return;
+
+    //方块本身，以及高度图变化导致天光来源改变的那一段
+    std::vector<IntVector3> changed(editedBlocks_.begin(), editedBlocks_.end());
+    for(auto &it : editedColumns_)
     {
-        IntVector3 pos = pgQueue.front();
-        pgQueue.pop_front();
-
-        int ckX = BlockXZ_To_ChunkXZ(pos.x);
-        int ckZ = BlockXZ_To_ChunkXZ(pos.z);
-
-        int blkX = BlockXZ_To_BlockXZInChunk(pos.x);
-        int blkZ = BlockXZ_To_BlockXZInChunk(pos.z);
-
-        Chunk *ck = GetChunk(ckX, ckZ);
-        Block blk = GetBlock(pos.x, pos.y, pos.z);
-        const BlockInfo &blkInfo = BlockInfoManager::GetInstance().GetBlockInfo(blk.type);
-        int lightDec = blkInfo.lightDec;
-
-        BlockLight pX = GetBlockLight(pos.x + 1, pos.y, pos.z),
-                   nX = GetBlockLight(pos.x - 1, pos.y, pos.z),
-                   pY = GetBlockLight(pos.x, pos.y + 1, pos.z),
-                   nY = GetBlockLight(pos.x, pos.y - 1, pos.z),
-                   pZ = GetBlockLight(pos.x, pos.y, pos.z + 1),
-                   nZ = GetBlockLight(pos.x, pos.y, pos.z - 1);
-
-        BlockLight newLight = MakeLight(
-            blkInfo.lightEmission.x,
-            blkInfo.lightEmission.y,
-            blkInfo.lightEmission.z,
-            pos.y > ck->GetHeight(blkX, blkZ) ? LIGHT_COMPONENT_MAX : LIGHT_COMPONENT_MIN);
-
-        auto Max6 = [=](int ori, int _0, int _1, int _2, int _3, int _4, int _5) -> int
-        {
-            return static_cast<std::uint8_t>((std::max)(
-            { (std::max)({ _0, _1, _2, _3, _4, _5 }) - lightDec, ori, static_cast<int>(LIGHT_COMPONENT_MIN) }));
-        };
+        int blkX = it.first.x, blkZ = it.first.z;
+        int oldH = it.second.oldHeight;
 
-        newLight = SetRed(newLight, Max6(GetRed(newLight), GetRed(pX), GetRed(nX),
-            GetRed(pY), GetRed(nY),
-            GetRed(pZ), GetRed(nZ)));
-        newLight = SetGreen(newLight, Max6(GetGreen(newLight), GetGreen(pX), GetGreen(nX),
-            GetGreen(pY), GetGreen(nY),
-            GetGreen(pZ), GetGreen(nZ)));
-        newLight = SetBlue(newLight, Max6(GetBlue(newLight), GetBlue(pX), GetBlue(nX),
-            GetBlue(pY), GetBlue(nY),
-            GetBlue(pZ), GetBlue(nZ)));
-        newLight = SetSunlight(newLight, Max6(GetSunlight(newLight), GetSunlight(pX), GetSunlight(nX),
-            GetSunlight(pY), GetSunlight(nY),
-            GetSunlight(pZ), GetSunlight(nZ)));
-
-        if(newLight != blk.light)
+        //只改了原高度以下的方块时，最高的非空气方块不会变
+        if(it.second.maxY < oldH)
+            continue;
+
+        Chunk *ck = TryGetChunk(BlockXZ_To_ChunkXZ(blkX), BlockXZ_To_ChunkXZ(blkZ));
+        if(!ck)
+            continue;
+        int cx = BlockXZ_To_BlockXZInChunk(blkX);
+        int cz = BlockXZ_To_BlockXZInChunk(blkZ);
+
+        int newH = CHUNK_MAX_HEIGHT - 1;
+        while(newH > 0 && ck->GetBlockType(cx, newH, cz) == BlockType::Air)
+            --newH;
+        if(newH == oldH)
+            continue;
+
+        int L, H;
+        std::tie(L, H) = std::minmax(newH, oldH);
+        for(int y = L + 1; y <= H; ++y)
         {
-            ck->SetBlockLight(blkX, pos.y, blkZ, newLight);
-            pgQueue.push_front({ pos.x + 1, pos.y, pos.z });
-            pgQueue.push_front({ pos.x - 1, pos.y, pos.z });
-            if(pos.y < CHUNK_MAX_HEIGHT - 1)
-                pgQueue.push_front({ pos.x, pos.y + 1, pos.z });
-            if(pos.y > 0)
-                pgQueue.push_front({ pos.x, pos.y - 1, pos.z });
-            pgQueue.push_front({ pos.x, pos.y, pos.z + 1 });
-            pgQueue.push_front({ pos.x, pos.y, pos.z - 1 });
+            IntVector3 pos = { blkX, y, blkZ };
+            if(!editedBlocks_.count(pos))
+                changed.push_back(pos);
         }
 
-        ComputeModelUpdates(pos.x, pos.y, pos.z, modelUpdates_);
+        ck->SetHeight(cx, cz, newH);
     }
+
+    editedBlocks_.clear();
+    editedColumns_.clear();
+
+    if(!changed.empty())
+        UpdateLight(changed);
+}
+
+void ChunkManager::UpdateLight(const std::vector<IntVector3> &changed)
+{
+    lightChanged_.clear();
+    lightUpdater_.Update(this, changed, lightChanged_);
+
+    for(const IntVector3 &pos : changed)
+        ComputeModelUpdates(pos.x, pos.y, pos.z, modelUpdates_);
+    for(const IntVector3 &pos : lightChanged_)
+        ComputeModelUpdates(pos.x, pos.y, pos.z, modelUpdates_);
 }
 
 bool ChunkManager::PickBlock(const Vector3 &origin, const Vector3 &dir,
                              float maxLen, float step, PickBlockFunc func,
                              Block &blk, BlockFace &face, IntVector3 &rtPos)
 {
+    BlockAccessor acc(this, true);
     float t = 0;
     Vector3 pos = origin, posStep = step * dir;
     while(t < maxLen)
@@ -147,14 +198,19 @@ bool ChunkManager::PickBlock(const Vector3 &origin, const Vector3 &dir,
             Camera_To_Block(pos.y),
             Camera_To_Block(pos.z)
         };
-        const Block &tBlk = GetBlock(tBlkPos.x, tBlkPos.y, tBlkPos.z);
+
+        int inX, inZ;
+        if(!acc.GetChunk(tBlkPos.x, tBlkPos.z, inX, inZ))
+            return false;
+
+        const Block &tBlk = acc.GetBlock(tBlkPos.x, tBlkPos.y, tBlkPos.z);
 
         if(func(tBlk))
         {
             blk = tBlk;
             rtPos = tBlkPos;
 
-            //tBlkPosĸͺĸཻ
+            //tBlkPos离哪个面最近，就和哪个面相交
             float disNegX = pos.x - static_cast<float>(tBlkPos.x);
             float disNegY = pos.y - static_cast<float>(tBlkPos.y);
             float disNegZ = pos.z - static_cast<float>(tBlkPos.z);
@@ -183,29 +239,65 @@ void ChunkManager::SetCentrePosition(int ckX, int ckZ)
 {
     if(centrePos_.x == ckX && centrePos_.z == ckZ)
         return;
+    IntVectorXZ oldCentre = centrePos_;
     centrePos_ = { ckX, ckZ };
 
-    //ɵ˷ΧChunk
-    decltype(chunks_) newChunks_;
-    for(auto it : chunks_)
+    //干掉出了范围的Chunk
+    chunks_.SetCentre(ckX, ckZ);
+    for(auto it : farChunks_)
+        Helper::SafeDeleteObjects(it.second);
+    farChunks_.clear();
+    urgentLoads_.clear();
+
+    //等着的区块出了加载范围就不会再来了，这些section放回modelUpdates_，
+    //和加载线程在窗口边缘的做法一样，把出了范围的相邻区块当作不存在来建模
+    //否则section会一直显示修改之前的模型，AddChunkData只会给还没有模型的section建模
+    for(auto it = waitingModelUpdates_.begin(); it != waitingModelUpdates_.end();)
     {
-        if(!InUnloadingRange(it.first.x, it.first.z))
-            Helper::SafeDeleteObjects(it.second);
+        if(!InLoadingRange(it->first.x, it->first.z))
+        {
+            modelUpdates_.insert(it->second.begin(), it->second.end());
+            it = waitingModelUpdates_.erase(it);
+        }
         else
-            newChunks_[it.first] = it.second;
+        {
+            ++it;
+        }
     }
-    chunks_ = std::move(newChunks_);
 
-    //ȡ˷Χļ
-    ckLoader_.DelTaskIf([=](ChunkLoaderTask *task) -> bool
+    //被卸载区块的模型任务全部作废
+    //否则区块重新加载后，如果没有新的派发覆盖版本号，旧数据建出来的模型会被换到新区块上
+    for(auto it = pendingModels_.begin(); it != pendingModels_.end();)
     {
-        assert(task != nullptr);
-        auto [x, z] = task->GetPosition();
-        return !InLoadingRange(x, z);
-    });
+        if(!chunks_.Find(it->first.x, it->first.z))
+            it = pendingModels_.erase(it);
+        else
+            ++it;
+    }
+    for(auto it = readyModels_.begin(); it != readyModels_.end();)
+    {
+        if(!chunks_.Find(it->pos.x, it->pos.z))
+        {
+            ChunkSectionModelsPool::GetInstance().Delete(it->models);
+            it = readyModels_.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    //出了范围的加载任务会在轮到它时被丢弃，剩下的任务按新中心重新排优先级
+    ckLoader_.SetCentrePosition(ckX, ckZ);
+
+    //创建新的任务
+    //旧加载范围内的位置要么已经有数据，要么已经有任务，只需要看新进入加载范围的那几行/列
+    auto InOldLoadingRange = [&](int x, int z) -> bool
+    {
+        return std::llabs(static_cast<long long>(x) - oldCentre.x) <= loadDistance_ &&
+               std::llabs(static_cast<long long>(z) - oldCentre.z) <= loadDistance_;
+    };
 
-    //µ
-    std::vector<IntVectorXZ> possibleLoadingTasks;
     int loadRangeXEnd = centrePos_.x + loadDistance_;
     int loadRangeZEnd = centrePos_.z + loadDistance_;
     for(int newCkX = centrePos_.x - loadDistance_; newCkX <= loadRangeXEnd; ++newCkX)
@@ -213,22 +305,23 @@ void ChunkManager::SetCentrePosition(int ckX, int ckZ)
         for(int newCkZ = centrePos_.z - loadDistance_; newCkZ <= loadRangeZEnd; ++newCkZ)
         {
             assert(InLoadingRange(newCkX, newCkZ));
-            if(chunks_.find({ newCkX, newCkZ }) == chunks_.end()) //ûݣҲû
+            if(InOldLoadingRange(newCkX, newCkZ))
+            {
+                //跳过这一列中和旧范围重叠的部分
+                newCkZ = static_cast<int>((std::min)(
+                    static_cast<long long>(oldCentre.z) + loadDistance_,
+                    static_cast<long long>(loadRangeZEnd)));
+                continue;
+            }
+            if(!chunks_.Find(newCkX, newCkZ)) //还没有这个区块的数据，也没有任务
                 ckLoader_.TryAddLoadingTask(this, newCkX, newCkZ);
         }
     }
-
-    ckLoader_.Sort([=](const IntVectorXZ &lhs, const IntVectorXZ &rhs) -> bool
-    {
-        return (lhs.x - ckX) * (lhs.x - ckX) + (lhs.z - ckZ) * (lhs.z - ckZ) >
-               (rhs.x - ckX) * (rhs.x - ckX) + (rhs.z - ckZ) * (rhs.z - ckZ);
-    });
 }
 
 void ChunkManager::MakeSectionModelInvalid(int x, int y, int z)
 {
-    auto it = chunks_.find({ x, z });
-    if(it == chunks_.end() || !InRenderRange(x, z))
+    if(!chunks_.Find(x, z) || !InRenderRange(x, z))
         return;
     modelUpdates_.insert({ x, y, z });
 }
@@ -236,20 +329,27 @@ void ChunkManager::MakeSectionModelInvalid(int x, int y, int z)
 void ChunkManager::AddChunkData(Chunk *ck)
 {
     assert(ck != nullptr);
-    decltype(chunks_)::iterator it;
     IntVectorXZ pos = ck->GetPosition();
 
-    //ѾˣֱӶ
-    if((it = chunks_.find(pos)) != chunks_.end())
+    //已经有了或者已经出了卸载范围，所以直接丢掉
+    if(chunks_.Find(pos.x, pos.z) || !chunks_.InWindow(pos.x, pos.z))
     {
-        assert(it->second);
         Helper::SafeDeleteObjects(ck);
         return;
     }
 
-    chunks_[pos] = ck;
+    chunks_.Add(ck);
+    urgentLoads_.erase(pos);
+
+    //在等这个区块的模型更新可以派发了
+    auto waitIt = waitingModelUpdates_.find(pos);
+    if(waitIt != waitingModelUpdates_.end())
+    {
+        modelUpdates_.insert(waitIt->second.begin(), waitIt->second.end());
+        waitingModelUpdates_.erase(waitIt);
+    }
 
-    if(InRenderRange(pos.x, pos.z)) //ǷҪģ
+    if(InRenderRange(pos.x, pos.z)) //是否需要创建模型任务
     {
         for(int section = 0; section != CHUNK_SECTION_NUM; ++section)
         {
@@ -261,63 +361,163 @@ void ChunkManager::AddChunkData(Chunk *ck)
 
 void ChunkManager::AddSectionModel(const IntVector3 &pos, ChunkSectionModels *models)
 {
-    assert(models != nullptr);
-    auto it = chunks_.find({ pos.x, pos.z });
-    if(it == chunks_.end())
+    if(!models)
+        return;
+    Chunk *ck = chunks_.Find(pos.x, pos.z);
+    if(!ck)
     {
-        Helper::SafeDeleteObjects(models);
+        ChunkSectionModelsPool::GetInstance().Delete(models);
         return;
     }
-    it->second->SetModels(pos.y, models);
+    ck->SetModels(pos.y, models);
+}
+
+Chunk *ChunkManager::TryGetChunk(int ckX, int ckZ)
+{
+    Chunk *ck = chunks_.Find(ckX, ckZ);
+    if(ck)
+        return ck;
+
+    auto farIt = farChunks_.find({ ckX, ckZ });
+    if(farIt != farChunks_.end())
+        return farIt->second;
+
+    //加载范围外的区块加载好了也会被丢掉，不必请求
+    if(InLoadingRange(ckX, ckZ) && urgentLoads_.insert(IntVectorXZ(ckX, ckZ)).second)
+        ckLoader_.TryAddUrgentLoadingTask(this, ckX, ckZ);
+    return nullptr;
 }
 
-void ChunkManager::LoadChunk(int ckX, int ckZ)
+bool ChunkManager::IsAreaLoaded(const AABB &aabb)
 {
-    assert(chunks_.find({ ckX, ckZ }) == chunks_.end());
+    int ckXL = BlockXZ_To_ChunkXZ(Camera_To_Block(aabb.L.x));
+    int ckZL = BlockXZ_To_ChunkXZ(Camera_To_Block(aabb.L.z));
+    int ckXH = BlockXZ_To_ChunkXZ(Camera_To_Block(aabb.H.x));
+    int ckZH = BlockXZ_To_ChunkXZ(Camera_To_Block(aabb.H.z));
+
+    bool rt = true;
+    for(int ckX = ckXL; ckX <= ckXH; ++ckX)
+    {
+        for(int ckZ = ckZL; ckZ <= ckZH; ++ckZ)
+        {
+            if(!TryGetChunk(ckX, ckZ))
+                rt = false;
+        }
+    }
+    return rt;
+}
+
+void ChunkManager::LoadArea(const AABB &aabb)
+{
+    int ckXL = BlockXZ_To_ChunkXZ(Camera_To_Block(aabb.L.x));
+    int ckZL = BlockXZ_To_ChunkXZ(Camera_To_Block(aabb.L.z));
+    int ckXH = BlockXZ_To_ChunkXZ(Camera_To_Block(aabb.H.x));
+    int ckZH = BlockXZ_To_ChunkXZ(Camera_To_Block(aabb.H.z));
+
+    for(int ckX = ckXL; ckX <= ckXH; ++ckX)
+    {
+        for(int ckZ = ckZL; ckZ <= ckZH; ++ckZ)
+            GetChunk(ckX, ckZ);
+    }
+}
+
+Chunk *ChunkManager::LoadChunk(int ckX, int ckZ)
+{
+    assert(!chunks_.Find(ckX, ckZ));
+
+    auto farIt = farChunks_.find({ ckX, ckZ });
+    if(farIt != farChunks_.end())
+        return farIt->second;
 
     Chunk *ck = new Chunk(this, { ckX, ckZ });
     ckLoader_.LoadChunkData(ck);
-    assert(ck != nullptr);
+
+    if(!chunks_.InWindow(ckX, ckZ))
+    {
+        farChunks_[{ ckX, ckZ }] = ck;
+        return ck;
+    }
+
     AddChunkData(ck);
+    return ck;
 }
 
 void ChunkManager::ProcessChunkLoaderMessages(void)
 {
-    std::queue<ChunkLoaderMessage*> msgs = ckLoader_.FetchAllMsgs();
-
-    while(msgs.size())
+    ChunkLoaderMessage msg;
+    while(ckLoader_.FetchMsg(msg))
     {
-        ChunkLoaderMessage *msg = msgs.front();
-        msgs.pop();
-
-        switch(msg->type)
+        switch(msg.type)
         {
         case ChunkLoaderMessage::ChunkLoaded:
-            if(InLoadingRange(msg->ckLoaded->GetPosition().x, msg->ckLoaded->GetPosition().z))
-                AddChunkData(msg->ckLoaded);
+            if(InLoadingRange(msg.ckLoaded->GetPosition().x, msg.ckLoaded->GetPosition().z))
+                AddChunkData(msg.ckLoaded);
             else
-                Helper::SafeDeleteObjects(msg->ckLoaded);
+                Helper::SafeDeleteObjects(msg.ckLoaded);
+            break;
+        case ChunkLoaderMessage::SectionModelBuilt:
+            {
+                IntVector3 pos = { msg.modelBuilt.x, msg.modelBuilt.section, msg.modelBuilt.z };
+                auto it = pendingModels_.find(pos);
+                if(it != pendingModels_.end() && it->second == msg.modelBuilt.version)
+                    readyModels_.push_back({ pos, msg.modelBuilt.version, msg.modelBuilt.models });
+                else //已经有更新的任务了
+                    ChunkSectionModelsPool::GetInstance().Delete(msg.modelBuilt.models);
+            }
             break;
         default:
             std::abort();
         }
-
-        Helper::SafeDeleteObjects(msg);
     }
 }
 
 void ChunkManager::ProcessModelUpdates(void)
 {
-    while(modelUpdates_.size())
+    //派发：旧模型一直留到新模型做好
+    //相邻区块没加载的section挂到waitingModelUpdates_上，旧模型继续用着
+    for(const IntVector3 &pos : modelUpdates_)
     {
-        IntVector3 pos = *modelUpdates_.begin();
-        modelUpdates_.erase(pos);
+        Chunk *ck = chunks_.Find(pos.x, pos.z);
+        if(!ck)
+            continue;
 
-        auto it = chunks_.find({ pos.x, pos.z });
-        if(it == chunks_.end())
+        ChunkModelBuilder builder(this, ck, pos.y);
+        IntVectorXZ missing;
+        if(!builder.AreNeighboursLoaded(missing))
+        {
+            waitingModelUpdates_[missing].push_back(pos);
+            continue;
+        }
+
+        if(ChunkSectionModels *models = builder.TryBuildTrivial())
+        {
+            pendingModels_.erase(pos);
+            AddSectionModel(pos, models);
             continue;
-        ChunkModelBuilder builder(this, it->second, pos.y);
-        AddSectionModel(pos, builder.Build());
+        }
+
+        unsigned int version = ++modelVersion_;
+        pendingModels_[pos] = version;
+        ckLoader_.AddModelTask(pos, version, builder.Capture());
+    }
+    modelUpdates_.clear();
+
+    //换上：派发之后又有了新版本的就丢掉
+    for(int swapCnt = 0; swapCnt < MODEL_SWAP_BUDGET_PER_FRAME && readyModels_.size();)
+    {
+        ReadyModel m = readyModels_.front();
+        readyModels_.pop_front();
+
+        auto it = pendingModels_.find(m.pos);
+        if(it == pendingModels_.end() || it->second != m.version)
+        {
+            ChunkSectionModelsPool::GetInstance().Delete(m.models);
+            continue;
+        }
+
+        pendingModels_.erase(it);
+        AddSectionModel(m.pos, m.models);
+        ++swapCnt;
     }
 }
 
@@ -325,12 +525,12 @@ void ChunkManager::Render(const Camera &cam, ChunkSectionRenderQueue *renderQueu
 {
     assert(renderQueue != nullptr);
 
-    for(auto it : chunks_)
+    chunks_.ForEach([&](Chunk *ck)
     {
-        if(!InRenderRange(it.first.x, it.first.z))
-            continue;
-        it.second->Render(cam, renderQueue);
-    }
+        IntVectorXZ pos = ck->GetPosition();
+        if(InRenderRange(pos.x, pos.z))
+            ck->Render(cam, renderQueue);
+    });
 }
 
 void ChunkManager::ComputeModelUpdates(int x, int y, int z,
@@ -395,7 +595,7 @@ void ChunkManager::ComputeModelUpdates(int x, int y, int z,
 
 bool ChunkManager::DetectCollision(const Vector3 &pnt)
 {
-    const BlockInfoManager &infoMgr = BlockInfoManager::GetInstance();
+    BlockAccessor acc(this, true);
 
     IntVector3 blkPos = Camera_To_Block(pnt);
     for(int dx = -1; dx <= 1; ++dx)
@@ -408,7 +608,7 @@ bool ChunkManager::DetectCollision(const Vector3 &pnt)
                 Vector3 vp = { static_cast<float>(p.x),
                                static_cast<float>(p.y),
                                static_cast<float>(p.z) };
-                if((infoMgr.GetAABB(GetBlockType(p.x, p.y, p.z)) + vp).IsPointIn(pnt))
+                if((GetCollisionAABB(acc, p.x, p.y, p.z) + vp).IsPointIn(pnt))
                     return true;
             }
         }
@@ -421,7 +621,7 @@ bool ChunkManager::DetectCollision(const AABB &aabb)
 {
     if(!aabb.IsValid())
         return false;
-    const BlockInfoManager &infoMgr = BlockInfoManager::GetInstance();
+    BlockAccessor acc(this, true);
     IntVector3 blkL = Camera_To_Block(aabb.L);
     IntVector3 blkH = Camera_To_Block(aabb.H);
 
@@ -434,7 +634,7 @@ bool ChunkManager::DetectCollision(const AABB &aabb)
                 Vector3 vp = { static_cast<float>(x),
                                static_cast<float>(y),
                                static_cast<float>(z) };
-                if((infoMgr.GetAABB(GetBlockType(x, y, z)) + vp).IsAABBIntersected(aabb))
+                if((GetCollisionAABB(acc, x, y, z) + vp).IsAABBIntersected(aabb))
                     return true;
             }
         }
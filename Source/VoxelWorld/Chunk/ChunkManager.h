@@ -11,6 +11,7 @@ Created by AirGuanZ
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <Utility/Math.h>
 #include <Utility/Uncopiable.h>
@@ -18,26 +19,49 @@ Created by AirGuanZ
 #include <Actor/Camera.h>
 #include <Block/BlockInfoManager.h>
 #include "Chunk.h"
+#include "ChunkGrid.h"
 #include "ChunkLoader.h"
+#include "LightUpdater.h"
 
 /*
-    Chunkݼؼģʹ
-        ߳άһPosition -> ChunkӳM̨Chunkݼغģʹ
+    Chunk数据加载及模型创建
+        主线程维护一个Position -> Chunk的映射M，后台负责Chunk的数据加载和模型创建
         
         setCentrePos
-            һChunk򳬳طΧжʱʣµģʹ
-            һµλýطΧloadDistanceʱ̴߳ɺ̨ɼ
+            当一个Chunk因超出加载范围而被卸载时，清空其剩下的模型创建任务
+            当一个新的位置进入加载范围（loadDistance）时，主线程创建加载任务，由后台完成加载
         implemented in SetCentrePosition
         
-        ̨ʱύɡϢ̣߳԰M
-        Ѿˣʧܣٴһų́
-        һChunkɹMʱȾΧڣӦģ
+        后台加载完成时，提交“加载完成”的消息给主线程，尝试把它加入M
+        如果已经有了（加入失败），就再创建一个数据销毁任务，让后台销毁它
+        当一个Chunk被成功加入M时，如果它在渲染范围内，创建对应的模型任务
         implemented in AddChunkData & ProcessChunkLoaderMessages
 
-        һģʱоģͣšģʱ滻ģ
+        当创建一个模型任务时，如果有旧模型，留着。当模型任务完成时，替换掉旧模型
         implemented in AddSectionModel
+
+        方块修改引起的模型更新在主线程截取section周围的方块，交给后台创建
+        每次派发都给这个section一个新的版本号，只有最新版本的结果会被换上去，
+        每帧换上去的模型数量有上限，剩下的留到下一帧
+        相邻区块还没加载时不在主线程同步加载，而是请求后台优先加载，
+        等它在AddChunkData中交付后再派发
+        implemented in ProcessModelUpdates
 */
 
+//遇到还没加载的区块时的处理方式
+enum class UnloadedChunkPolicy
+{
+    LoadNow, //立即在主线程同步加载，可能卡顿很久
+    Freeze,  //请求后台优先加载，调用者在加载好之前暂停相关的更新
+};
+
+//批量修改中的一项
+struct BlockEdit
+{
+    IntVector3 pos;
+    BlockType type;
+};
+
 class ChunkManager
 {
 public:
@@ -47,18 +71,24 @@ public:
     void StartLoading(int loaderCount);
     void Destroy(void);
 
-    //صChunkڱ֡ھʧЧ
+    //返回的Chunk在本帧内绝不会失效
+    //区块还没加载时会在主线程同步加载，可能卡顿很久
     Chunk *GetChunk(int ckX, int ckZ)
     {
-        auto it = chunks_.find({ ckX, ckZ });
-        if(it != chunks_.end())
-            return it->second;
+        Chunk *ck = chunks_.Find(ckX, ckZ);
+        if(ck)
+            return ck;
+        return LoadChunk(ckX, ckZ);
+    }
 
-        LoadChunk(ckX, ckZ);
+    //不会阻塞的版本，区块还没加载时返回nullptr，并请求后台优先加载它
+    Chunk *TryGetChunk(int ckX, int ckZ);
 
-        assert((chunks_[{ ckX, ckZ }] != nullptr));
-        return chunks_[{ ckX, ckZ }];
-    }
+    //aabb覆盖的区块是否都已加载，没加载的会被请求后台优先加载
+    bool IsAreaLoaded(const AABB &aabb);
+
+    //在主线程同步加载aabb覆盖的区块，可能卡顿很久
+    void LoadArea(const AABB &aabb);
 
     BlockType GetBlockType(int blkX, int blkY, int blkZ)
     {
@@ -96,54 +126,38 @@ public:
         return GetChunk(ck.x, ck.z)->GetBlock(cb.x, blkY, cb.z);
     }
 
-    void SetBlockType(int blkX, int blkY, int blkZ, BlockType type)
+    //修改一个方块，不在批量修改中时立即更新高度图、光照和模型
+    //修改还没加载的区块没有意义，会被忽略
+    void SetBlockType(int blkX, int blkY, int blkZ, BlockType type);
+
+    /*
+    批量修改方块（爆炸、放置建筑、区域填充等）
+        BeginEdit和Commit之间的修改只写入方块数据，Commit时统一重算涉及的高度图列，
+        做一次合并的光照更新，每个受影响的section只更新一次模型
+        可以嵌套，最外层的Commit才真正提交
+    */
+    void BeginEdit(void);
+    void SetBlocks(const std::vector<BlockEdit> &edits);
+    void Commit(void);
+
+    //changed中的方块发生了改变（方块类型或者天光来源），增量更新受影响的光照和模型
+    void UpdateLight(const std::vector<IntVector3> &changed);
+
+    //最近一次光照更新的统计
+    const LightUpdateStats &GetLightUpdateStats(void) const
     {
-        if(blkY < 0 || blkY >= CHUNK_MAX_HEIGHT)
-            return;
-
-        Chunk *ck = GetChunk(BlockXZ_To_ChunkXZ(blkX), BlockXZ_To_ChunkXZ(blkZ));
-
-        int cx = BlockXZ_To_BlockXZInChunk(blkX);
-        int cz = BlockXZ_To_BlockXZInChunk(blkZ);
-
-        ck->SetBlockType(cx, blkY, cz, type);
-
-        if(blkY >= ck->heightMap[Chunk::XZ(cx, cz)])
-        {
-            int newH = CHUNK_MAX_HEIGHT - 1;
-            while(newH > 0 && ck->GetBlockType(cx, newH, cz) == BlockType::Air)
-                --newH;
-
-            if(newH != ck->GetHeight(cx, cz))
-            {
-                int L, H;
-                std::tie(L, H) = std::minmax(newH, ck->heightMap[Chunk::XZ(cx, cz)]);
-
-                while(H >= L)
-                    UpdateLight(blkX, H--, blkZ);
-
-                ck->heightMap[Chunk::XZ(cx, cz)] = newH;
-            }
-        }
-
-        if(BlockInfoManager::GetInstance().IsGlow(type))
-            RemoveLightSource(blkX, blkY, blkZ);
-        else
-            UpdateLight(blkX, blkY, blkZ);
+        return lightUpdater_.GetStats();
     }
 
-    void RemoveLightSource(int x, int y, int z);
-
-    void UpdateLight(int x, int y, int z);
-
-    //Ըߺеķ
-    //trueҽmaxLenҵPickBlockFuncķ
-    //ֵΪtrue
-    //      blkŵһķ
-    //      faceָǴһ÷
-    //      rtPosָ÷Blockϵеλ
-    //ԭķڲfaceֵΪֵеһ
-    //ע⣺λԽdummyBlockҲһ󽻹
+    //以给定的射线和已有的方块求交
+    //返回true当且仅当在maxLen内找到了满足PickBlockFunc的方块
+    //若返回值为true，则
+    //      blk存放第一个满足条件的方块
+    //      face指出是从哪一面进入该方块的
+    //      rtPos指出该方块在Block坐标系中的位置
+    //若原点就在满足条件的方块内部，则face值为六个值中的任一个
+    //注意：位置越界的dummyBlock也会参与这一求交过程
+    //射线进入还没加载的区块时停止，返回false
     using PickBlockFunc = bool(*)(const Block&);
     bool PickBlock(const Vector3 &origin, const Vector3 &dir,
                    float maxLen, float step, PickBlockFunc func,
@@ -177,16 +191,22 @@ public:
 
     void Render(const Camera &cam, ChunkSectionRenderQueue *renderQueue);
 
+    //不会阻塞，还没加载的区块视为实心
     bool DetectCollision(const Vector3 &pnt);
     bool DetectCollision(const AABB &aabb);
 
+    ChunkLoaderStats GetLoaderStats(void)
+    {
+        return ckLoader_.GetStats();
+    }
+
 private:
-    //һغõChunk
+    //交付一个加载好的Chunk
     void AddChunkData(Chunk *ck);
-    //һõModel
+    //交付一个创建好的Model，models为nullptr（创建缓冲失败）时保留旧模型
     void AddSectionModel(const IntVector3 &pos, ChunkSectionModels *models);
-    //̼߳
-    void LoadChunk(int ckX, int ckZ);
+    //立即在主线程加载区块数据
+    Chunk *LoadChunk(int ckX, int ckZ);
 
     void ComputeModelUpdates(int x, int y, int z, std::unordered_set<IntVector3, IntVector3Hasher> &updates);
 
@@ -196,9 +216,43 @@ private:
     int unloadDistance_;
     IntVectorXZ centrePos_;
 
-    std::unordered_map<IntVectorXZ, Chunk*, IntVectorXZHasher> chunks_;
+    //卸载范围内的区块
+    ChunkGrid chunks_;
+    //卸载范围外被临时要求加载的区块，很少出现，下一次SetCentrePosition时清掉
+    std::unordered_map<IntVectorXZ, Chunk*, IntVectorXZHasher> farChunks_;
+    //已经请求后台优先加载的区块，避免每次TryGetChunk都去锁Loader的任务队列
+    std::unordered_set<IntVectorXZ, IntVectorXZHasher> urgentLoads_;
     
     std::unordered_set<IntVector3, IntVector3Hasher> modelUpdates_;
+    //因相邻区块还没加载而推迟的模型更新，键是在等的区块
+    std::unordered_map<IntVectorXZ, std::vector<IntVector3>, IntVectorXZHasher> waitingModelUpdates_;
+
+    //后台正在创建的模型的最新版本号
+    std::unordered_map<IntVector3, unsigned int, IntVector3Hasher> pendingModels_;
+    unsigned int modelVersion_;
+
+    struct ReadyModel
+    {
+        IntVector3 pos;
+        unsigned int version;
+        ChunkSectionModels *models;
+    };
+    //后台创建好、等着换上去的模型
+    std::deque<ReadyModel> readyModels_;
+
+    LightUpdater lightUpdater_;
+    std::vector<IntVector3> lightChanged_;
+
+    struct EditedColumn
+    {
+        int oldHeight; //第一次修改前的高度
+        int maxY;      //修改过的最高位置
+    };
+    //BeginEdit的嵌套层数
+    int editDepth_;
+    //尚未提交的修改，坐标都是方块坐标
+    std::unordered_set<IntVector3, IntVector3Hasher> editedBlocks_;
+    std::unordered_map<IntVectorXZ, EditedColumn, IntVectorXZHasher> editedColumns_;
 
     ChunkLoader ckLoader_;
 };
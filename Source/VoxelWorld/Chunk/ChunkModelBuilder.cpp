@@ -3,172 +3,239 @@ Filename: ChunkModelBuilder.cpp
 Date: 2018.1.18
 Created by AirGuanZ
 ================================================================*/
+#include <atomic>
+#include <chrono>
+
 #include <Block/BlockInfoManager.h>
 #include <Block/BlockModelBuilder.h>
+#include "BlockAccessor.h"
 #include "Chunk.h"
 #include "ChunkManager.h"
 #include "ChunkModelBuilder.h"
-#include "ChunkTraversal.h"
+#include "ChunkSectionModelsPool.h"
+#include "ChunkSectionSnapshot.h"
+#include "GreedyBoxMesher.h"
 
-ChunkModelBuilder::ChunkModelBuilder(ChunkManager *ckMgr, Chunk *ck, int section)
-    : ckMgr_(ckMgr), ck_(ck), section_(section)
+namespace
 {
+    std::atomic<bool> greedyMeshing(true);
+
+    std::atomic<size_t> meshedSections(0);
+    std::atomic<size_t> meshedBasicVertices(0);
+    std::atomic<size_t> meshedGeometryBytes(0);
+    std::atomic<long long> meshMicroseconds(0);
+
+    //ck为空（还没加载）时返回false
+    bool IsUniformBasicSection(const Chunk *ck, int section)
+    {
+        return ck && ck->IsSectionUniform(section) &&
+               BlockInfoManager::GetInstance().GetBlockInfo(
+                    ck->GetSectionUniformType(section)).renderer == BlockRenderer::BasicRenderer;
+    }
+
+    //section可以整个跳过的两种情况：
+    //    1. 全部是不需要渲染的方块，典型的是地表以上的空气
+    //    2. 全部是BasicRenderer的方块，且六个相邻section也是，这时不可能有可见的面
+    //最底层section的下方和最高层section的上方都视为暴露在外
+    bool CanSkipSection(const Chunk *ck, const Chunk *nX, const Chunk *pX,
+                        const Chunk *nZ, const Chunk *pZ, int section)
+    {
+        if(!ck->IsSectionUniform(section))
+            return false;
+        if(!BlockInfoManager::GetInstance().IsRenderable(ck->GetSectionUniformType(section)))
+            return true;
+        return 0 < section && section < CHUNK_SECTION_NUM - 1 &&
+               IsUniformBasicSection(ck, section) &&
+               IsUniformBasicSection(ck, section - 1) && IsUniformBasicSection(ck, section + 1) &&
+               IsUniformBasicSection(nX, section) && IsUniformBasicSection(pX, section) &&
+               IsUniformBasicSection(nZ, section) && IsUniformBasicSection(pZ, section);
+    }
 
+    //用geometry中的面为models创建缓冲，geometry可以就是models
+    //有缓冲创建失败时把models还给池子并置为nullptr，geometry中的面无论如何都会被清掉
+    void MakeSectionVertexBuffers(ChunkSectionModels *&models, ChunkSectionModels &geometry)
+    {
+        bool ok = true;
+        for(int i = 0; i != BASIC_RENDERER_TEXTURE_NUM; ++i)
+            ok = models->basic[i].MakeVertexBuffer(geometry.basic[i]) && ok;
+        for(int i = 0; i != CARVE_RENDERER_TEXTURE_NUM; ++i)
+            ok = models->carve[i].MakeVertexBuffer(geometry.carve[i]) && ok;
+        for(int i = 0; i != LIQUID_RENDERER_TEXTURE_NUM; ++i)
+            ok = models->liquid[i].MakeVertexBuffer(geometry.liquid[i]) && ok;
+
+        if(!ok)
+            ChunkSectionModelsPool::GetInstance().Delete(models);
+    }
+
+    //每个建模线程自己的临时空间
+    //    builder把面写进scratch的模型，上传显存后清空但保留容量，下一个section接着用
+    struct MeshScratch
+    {
+        ChunkSectionModels geometry;
+        GreedyBoxMesher greedy;
+    };
+
+    MeshScratch &GetThreadMeshScratch(void)
+    {
+        thread_local MeshScratch scratch;
+        return scratch;
+    }
 }
 
-ChunkSectionModels *ChunkModelBuilder::Build(void)
+ChunkMeshStats GetChunkMeshStats(void)
 {
-    assert(ckMgr_ != nullptr && ck_ != nullptr);
+    return { meshedSections, meshedBasicVertices, meshedGeometryBytes, meshMicroseconds / 1000.0f };
+}
 
-    int xBase = ck_->GetXPosBase();
-    int zBase = ck_->GetZPosBase();
-    int yBase = ChunkSectionIndex_To_BlockY(section_);
+void ResetChunkMeshStats(void)
+{
+    meshedSections = 0;
+    meshedBasicVertices = 0;
+    meshedGeometryBytes = 0;
+    meshMicroseconds = 0;
+}
 
-    ChunkSectionModels *models = new ChunkSectionModels;
+void SetGreedyMeshingEnabled(bool enabled)
+{
+    greedyMeshing = enabled;
+}
 
-    for(const IntVector3 &f : ChunkTraversal::GetInstance().ChunkFaces())
-    {
-        int x = f.x + xBase, y = f.y + yBase, z = f.z + zBase;
+bool IsGreedyMeshingEnabled(void)
+{
+    return greedyMeshing;
+}
 
-        Block blk = ckMgr_->GetBlock(x, y, z);
-        if(!BlockInfoManager::GetInstance().IsRenderable(blk.type))
-            continue;
+ChunkModelBuilder::ChunkModelBuilder(ChunkManager *ckMgr, Chunk *ck, int section)
+    : ckMgr_(ckMgr), ck_(ck), section_(section)
+{
 
-        const Block blks[3][3][3] =
-        {
-            {
-                { ckMgr_->GetBlock(x - 1, y - 1, z - 1), ckMgr_->GetBlock(x - 1, y - 1, z), ckMgr_->GetBlock(x - 1, y - 1, z + 1) }, //[0][0]
-                { ckMgr_->GetBlock(x - 1, y, z - 1),     ckMgr_->GetBlock(x - 1, y, z),     ckMgr_->GetBlock(x - 1, y, z + 1) },     //[0][1]
-                { ckMgr_->GetBlock(x - 1, y + 1, z - 1), ckMgr_->GetBlock(x - 1, y + 1, z), ckMgr_->GetBlock(x - 1, y + 1, z + 1) }, //[0][2]
-            },
-            {
-                { ckMgr_->GetBlock(x, y - 1, z - 1), ckMgr_->GetBlock(x, y - 1, z), ckMgr_->GetBlock(x, y - 1, z + 1) },             //[0][0]
-                { ckMgr_->GetBlock(x, y, z - 1),     ckMgr_->GetBlock(x, y, z),     ckMgr_->GetBlock(x, y, z + 1) },                 //[0][1]
-                { ckMgr_->GetBlock(x, y + 1, z - 1), ckMgr_->GetBlock(x, y + 1, z), ckMgr_->GetBlock(x, y + 1, z + 1) },             //[0][2]
-            },
-            {
-                { ckMgr_->GetBlock(x + 1, y - 1, z - 1), ckMgr_->GetBlock(x + 1, y - 1, z), ckMgr_->GetBlock(x + 1, y - 1, z + 1) }, //[0][0]
-                { ckMgr_->GetBlock(x + 1, y, z - 1),     ckMgr_->GetBlock(x + 1, y, z),     ckMgr_->GetBlock(x + 1, y, z + 1) },     //[0][1]
-                { ckMgr_->GetBlock(x + 1, y + 1, z - 1), ckMgr_->GetBlock(x + 1, y + 1, z), ckMgr_->GetBlock(x + 1, y + 1, z + 1) }, //[0][2]
-            }
-        };
-        GetBlockModelBuilder(blk.type)->Build(
-            Vector3(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z)),
-            blks, models);
-    }
+}
 
-    for(int Lx = 1; Lx < CHUNK_SECTION_SIZE - 1; ++Lx)
+bool ChunkModelBuilder::AreNeighboursLoaded(IntVectorXZ &missing) const
+{
+    assert(ckMgr_ != nullptr && ck_ != nullptr);
+
+    IntVectorXZ ckPos = ck_->GetPosition();
+    bool rt = true;
+    for(int dx = -1; dx <= 1; ++dx)
     {
-        int x = Lx + xBase;
-        for(int Lz = 1; Lz < CHUNK_SECTION_SIZE - 1; ++Lz)
+        for(int dz = -1; dz <= 1; ++dz)
         {
-            int z = Lz + zBase;
-            for(int Ly = 1; Ly < CHUNK_SECTION_SIZE - 1; ++Ly)
+            int x = ckPos.x + dx, z = ckPos.z + dz;
+            if(ckMgr_->InLoadingRange(x, z) && !ckMgr_->TryGetChunk(x, z))
             {
-                int y = Ly + yBase;
-
-                Block blk = ck_->GetBlock(Lx, y, Lz);
-                if(!BlockInfoManager::GetInstance().IsRenderable(blk.type))
-                    continue;
-
-                const Block blks[3][3][3] =
-                {
-                    {
-                        { ck_->GetBlock(Lx - 1, y - 1, Lz - 1), ck_->GetBlock(Lx - 1, y - 1, Lz), ck_->GetBlock(Lx - 1, y - 1, Lz + 1) }, //[0][0]
-                        { ck_->GetBlock(Lx - 1, y, Lz - 1),     ck_->GetBlock(Lx - 1, y, Lz),     ck_->GetBlock(Lx - 1, y, Lz + 1) },     //[0][1]
-                        { ck_->GetBlock(Lx - 1, y + 1, Lz - 1), ck_->GetBlock(Lx - 1, y + 1, Lz), ck_->GetBlock(Lx - 1, y + 1, Lz + 1) }, //[0][2]
-                    },
-                    {
-                        { ck_->GetBlock(Lx, y - 1, Lz - 1), ck_->GetBlock(Lx, y - 1, Lz), ck_->GetBlock(Lx, y - 1, Lz + 1) },             //[0][0]
-                        { ck_->GetBlock(Lx, y, Lz - 1),     ck_->GetBlock(Lx, y, Lz),     ck_->GetBlock(Lx, y, Lz + 1) },                 //[0][1]
-                        { ck_->GetBlock(Lx, y + 1, Lz - 1), ck_->GetBlock(Lx, y + 1, Lz), ck_->GetBlock(Lx, y + 1, Lz + 1) },             //[0][2]
-                    },
-                    {
-                        { ck_->GetBlock(Lx + 1, y - 1, Lz - 1), ck_->GetBlock(Lx + 1, y - 1, Lz), ck_->GetBlock(Lx + 1, y - 1, Lz + 1) }, //[0][0]
-                        { ck_->GetBlock(Lx + 1, y, Lz - 1),     ck_->GetBlock(Lx + 1, y, Lz),     ck_->GetBlock(Lx + 1, y, Lz + 1) },     //[0][1]
-                        { ck_->GetBlock(Lx + 1, y + 1, Lz - 1), ck_->GetBlock(Lx + 1, y + 1, Lz), ck_->GetBlock(Lx + 1, y + 1, Lz + 1) }, //[0][2]
-                    }
-                };
-                GetBlockModelBuilder(blk.type)->Build(
-                    Vector3(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z)),
-                    blks, models);
+                missing = { x, z };
+                rt = false;
             }
         }
     }
+    return rt;
+}
 
-    for(int i = 0; i != BASIC_RENDERER_TEXTURE_NUM; ++i)
-        models->basic[i].MakeVertexBuffer();
-    for(int i = 0; i != CARVE_RENDERER_TEXTURE_NUM; ++i)
-        models->carve[i].MakeVertexBuffer();
-    for(int i = 0; i != LIQUID_RENDERER_TEXTURE_NUM; ++i)
-        models->liquid[i].MakeVertexBuffer();
+ChunkSectionModels *ChunkModelBuilder::TryBuildTrivial(void)
+{
+    assert(ckMgr_ != nullptr && ck_ != nullptr);
+
+    IntVectorXZ ckPos = ck_->GetPosition();
+    if(!CanSkipSection(ck_, ckMgr_->TryGetChunk(ckPos.x - 1, ckPos.z), ckMgr_->TryGetChunk(ckPos.x + 1, ckPos.z),
+                            ckMgr_->TryGetChunk(ckPos.x, ckPos.z - 1), ckMgr_->TryGetChunk(ckPos.x, ckPos.z + 1),
+                            section_))
+        return nullptr;
+
+    ChunkSectionModels *models = ChunkSectionModelsPool::GetInstance().New();
+    MakeSectionVertexBuffers(models, *models);
     return models;
 }
 
-ChunkSectionModels *BackgroundChunkModelBuilder::Build(Chunk *(&cks)[3][3], int section) const
+ChunkSectionSnapshot *ChunkModelBuilder::Capture(void)
 {
-    Chunk *ck = cks[1][1];
+    assert(ckMgr_ != nullptr && ck_ != nullptr);
+
+    IntVectorXZ ckPos = ck_->GetPosition();
+    ChunkSectionSnapshot *snapshot = new ChunkSectionSnapshot({ ckPos.x, section_, ckPos.z });
+    BlockAccessor acc(ckMgr_, true);
+    snapshot->Capture(acc);
+    return snapshot;
+}
 
-    int xBase = ck->GetXPosBase();
-    int zBase = ck->GetZPosBase();
-    int yBase = ChunkSectionIndex_To_BlockY(section);
+ChunkSectionModels *SnapshotChunkModelBuilder::Build(const ChunkSectionSnapshot &snapshot) const
+{
+    auto start = std::chrono::steady_clock::now();
 
-    ChunkSectionModels *models = new ChunkSectionModels;
+    const IntVector3 &sectionPos = snapshot.GetSectionPosition();
+    int xBase = ChunkXZ_To_BlockXZ(sectionPos.x);
+    int yBase = ChunkSectionIndex_To_BlockY(sectionPos.y);
+    int zBase = ChunkXZ_To_BlockXZ(sectionPos.z);
 
-    auto GetBlock = [&](int x, int y, int z) -> Block
-    {
-        if((y < 0) | (y >= CHUNK_MAX_HEIGHT))
-            return { BlockType::Air, LIGHT_ALL_MAX };
-        return cks[x / CHUNK_SECTION_SIZE][z / CHUNK_SECTION_SIZE]
-            ->GetBlock(x % CHUNK_SECTION_SIZE, y, z % CHUNK_SECTION_SIZE);
-    };
+    MeshScratch &scratch = GetThreadMeshScratch();
+    ChunkSectionModels &geometry = scratch.geometry;
+    bool greedy = greedyMeshing;
 
     for(int Lx = 0; Lx < CHUNK_SECTION_SIZE; ++Lx)
     {
-        int x = Lx + CHUNK_SECTION_SIZE;
         for(int Lz = 0; Lz < CHUNK_SECTION_SIZE; ++Lz)
         {
-            int z = Lz + CHUNK_SECTION_SIZE;
             for(int Ly = 0; Ly < CHUNK_SECTION_SIZE; ++Ly)
             {
-                int y = Ly + yBase;
-
-                Block blk = GetBlock(x, y, z);
-                if(!BlockInfoManager::GetInstance().IsRenderable(blk.type))
+                //不可渲染的方块renderer都是Null，建模方式也是Null
+                const Block &blk = snapshot.GetBlock(Lx, Ly, Lz);
+                BlockModelBuilderKind kind = GetBlockModelBuilderKind(blk.type);
+                if(kind == BlockModelBuilderKind::Null)
+                    continue;
+                if(greedy && kind == BlockModelBuilderKind::BasicRenderer_Box)
                     continue;
 
-                const Block blks[3][3][3] =
-                {
-                    {
-                        { GetBlock(x - 1, y - 1, z - 1), GetBlock(x - 1, y - 1, z), GetBlock(x - 1, y - 1, z + 1) }, //[0][0]
-                        { GetBlock(x - 1, y, z - 1),     GetBlock(x - 1, y, z),     GetBlock(x - 1, y, z + 1) },     //[0][1]
-                        { GetBlock(x - 1, y + 1, z - 1), GetBlock(x - 1, y + 1, z), GetBlock(x - 1, y + 1, z + 1) }, //[0][2]
-                    },
-                    {
-                        { GetBlock(x, y - 1, z - 1), GetBlock(x, y - 1, z), GetBlock(x, y - 1, z + 1) },             //[0][0]
-                        { GetBlock(x, y, z - 1),     blk,                   GetBlock(x, y, z + 1) },                 //[0][1]
-                        { GetBlock(x, y + 1, z - 1), GetBlock(x, y + 1, z), GetBlock(x, y + 1, z + 1) },             //[0][2]
-                    },
-                    {
-                        { GetBlock(x + 1, y - 1, z - 1), GetBlock(x + 1, y - 1, z), GetBlock(x + 1, y - 1, z + 1) }, //[0][0]
-                        { GetBlock(x + 1, y, z - 1),     GetBlock(x + 1, y, z),     GetBlock(x + 1, y, z + 1) },     //[0][1]
-                        { GetBlock(x + 1, y + 1, z - 1), GetBlock(x + 1, y + 1, z), GetBlock(x + 1, y + 1, z + 1) }, //[0][2]
-                    }
-                };
-                GetBlockModelBuilder(blk.type)->Build(
+                BuildBlockModel(kind,
                     Vector3(static_cast<float>(Lx + xBase),
-                            static_cast<float>(y),
+                            static_cast<float>(Ly + yBase),
                             static_cast<float>(Lz + zBase)),
-                    blks, models);
+                    { Lx, Ly, Lz }, snapshot.GetNeighbourhood(Lx, Ly, Lz), &geometry);
             }
         }
     }
 
+    if(greedy)
+        scratch.greedy.Build(snapshot, &geometry);
+
+    size_t basicVertices = 0, geometryBytes = 0;
     for(int i = 0; i != BASIC_RENDERER_TEXTURE_NUM; ++i)
-        models->basic[i].MakeVertexBuffer();
+    {
+        basicVertices += geometry.basic[i].GetVerticesCount();
+        geometryBytes += geometry.basic[i].GetGeometryBytes();
+    }
     for(int i = 0; i != CARVE_RENDERER_TEXTURE_NUM; ++i)
-        models->carve[i].MakeVertexBuffer();
+        geometryBytes += geometry.carve[i].GetGeometryBytes();
     for(int i = 0; i != LIQUID_RENDERER_TEXTURE_NUM; ++i)
-        models->liquid[i].MakeVertexBuffer();
+        geometryBytes += geometry.liquid[i].GetGeometryBytes();
+
+    //最终的模型只有显存中大小正好的缓冲，CPU上不再留副本
+    ChunkSectionModels *models = ChunkSectionModelsPool::GetInstance().New();
+    MakeSectionVertexBuffers(models, geometry);
+
+    meshedSections += 1;
+    meshedBasicVertices += basicVertices;
+    meshedGeometryBytes += geometryBytes;
+    meshMicroseconds += std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+
     return models;
 }
+
+ChunkSectionModels *BackgroundChunkModelBuilder::Build(const Chunk *(&cks)[3][3], int section) const
+{
+    const Chunk *ck = cks[1][1];
+
+    if(CanSkipSection(ck, cks[0][1], cks[2][1], cks[1][0], cks[1][2], section))
+    {
+        ChunkSectionModels *models = ChunkSectionModelsPool::GetInstance().New();
+        MakeSectionVertexBuffers(models, *models);
+        return models;
+    }
+
+    //贪心合并需要整个section，所以和主线程一样先截取再创建
+    IntVectorXZ ckPos = ck->GetPosition();
+    ChunkSectionSnapshot snapshot({ ckPos.x, section, ckPos.z });
+    BlockAccessor acc(cks);
+    snapshot.Capture(acc);
+    return SnapshotChunkModelBuilder().Build(snapshot);
+}
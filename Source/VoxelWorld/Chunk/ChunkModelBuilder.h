@@ -5,18 +5,50 @@ Created by AirGuanZ
 ================================================================*/
 #pragma once
 
+#include <cstddef>
+
 #include <Utility/Uncopiable.h>
 
 #include <Block/BlockModelBuilder.h>
 
 class ChunkManager;
 
+class ChunkSectionSnapshot;
+
+//section模型创建的统计，所有线程累计，用于比较不同的建模方式
+struct ChunkMeshStats
+{
+    size_t sections;
+    //BasicRenderer的顶点数
+    size_t basicVertices;
+    //上传显存之前所有模型的顶点和下标的字节数
+    size_t geometryBytes;
+    float milliseconds;
+};
+
+ChunkMeshStats GetChunkMeshStats(void);
+void ResetChunkMeshStats(void);
+
+//BasicRenderer的Box方块是否使用贪心合并，关掉时逐个方块输出面，只影响之后创建的模型
+void SetGreedyMeshingEnabled(bool enabled);
+bool IsGreedyMeshingEnabled(void);
+
+//主线程上的模型更新：能直接确定结果的当场做完，否则截取方块交给后台
+//    只用不会阻塞的方式取相邻区块，不会在主线程同步加载区块
 class ChunkModelBuilder : public Uncopiable
 {
 public:
     ChunkModelBuilder(ChunkManager *ckMgr, Chunk *ck, int section);
 
-    ChunkSectionModels *Build(void);
+    //相邻的八个区块是否都已加载，没加载的会被请求后台优先加载，missing返回其中一个的位置
+    //加载范围外的区块永远不会被加载，不算在内，截取时当作窗口外处理
+    bool AreNeighboursLoaded(IntVectorXZ &missing) const;
+
+    //整个section都不需要面时直接返回空模型，否则（包括创建缓冲失败）返回nullptr
+    ChunkSectionModels *TryBuildTrivial(void);
+
+    //截取创建模型需要的方块，交给SnapshotChunkModelBuilder
+    ChunkSectionSnapshot *Capture(void);
 
 private:
     ChunkManager *ckMgr_;
@@ -27,5 +59,13 @@ private:
 class BackgroundChunkModelBuilder : public Uncopiable
 {
 public:
-    ChunkSectionModels *Build(Chunk *(&cks)[3][3], int section) const;
+    ChunkSectionModels *Build(const Chunk *(&cks)[3][3], int section) const;
+};
+
+//只依赖截图，可以在任意线程使用
+//和BackgroundChunkModelBuilder一样，创建显存缓冲失败时返回nullptr
+class SnapshotChunkModelBuilder : public Uncopiable
+{
+public:
+    ChunkSectionModels *Build(const ChunkSectionSnapshot &snapshot) const;
 };
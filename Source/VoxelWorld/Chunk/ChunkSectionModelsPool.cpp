@@ -0,0 +1,56 @@
+/*================================================================
+Filename: ChunkSectionModelsPool.cpp
+Date: 2018.2.15
+Created by AirGuanZ
+================================================================*/
+#include <Utility/HelperFunctions.h>
+
+#include "ChunkSectionModelsPool.h"
+
+SINGLETON_CLASS_DEFINITION(ChunkSectionModelsPool);
+
+ChunkSectionModelsPool::~ChunkSectionModelsPool(void)
+{
+    for(ChunkSectionModels *models : free_)
+        Helper::SafeDeleteObjects(models);
+    free_.clear();
+}
+
+ChunkSectionModels *ChunkSectionModelsPool::New(void)
+{
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        if(!free_.empty())
+        {
+            ChunkSectionModels *rt = free_.back();
+            free_.pop_back();
+            return rt;
+        }
+    }
+    return new ChunkSectionModels;
+}
+
+void ChunkSectionModelsPool::Delete(ChunkSectionModels *&models)
+{
+    if(!models)
+        return;
+
+    //显存中的缓冲在放回池子之前释放，池子里只留空壳
+    for(BasicModel &m : models->basic)
+        m.Destroy();
+    for(CarveModel &m : models->carve)
+        m.Destroy();
+    for(LiquidModel &m : models->liquid)
+        m.Destroy();
+
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        if(free_.size() < MAX_FREE_NUM)
+        {
+            free_.push_back(models);
+            models = nullptr;
+            return;
+        }
+    }
+    Helper::SafeDeleteObjects(models);
+}
@@ -0,0 +1,36 @@
+/*================================================================
+Filename: ChunkSectionModelsPool.h
+Date: 2018.2.15
+Created by AirGuanZ
+================================================================*/
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+#include <Utility/Singleton.h>
+
+#include "Chunk.h"
+
+/*
+ChunkSectionModels的回收池，可以在任意线程使用
+    加载线程不停地为section创建模型，主线程不停地替换、丢弃旧模型，
+    用完的对象释放显存中的缓冲后留在池子里，下次直接拿出来用
+    池子里最多保留MAX_FREE_NUM个，多出来的直接删除
+*/
+class ChunkSectionModelsPool : public Singleton<ChunkSectionModelsPool>
+{
+public:
+    ~ChunkSectionModelsPool(void);
+
+    ChunkSectionModels *New(void);
+
+    //和Helper::SafeDeleteObjects一样，models可以为空，之后被置为nullptr
+    void Delete(ChunkSectionModels *&models);
+
+private:
+    static constexpr size_t MAX_FREE_NUM = 1024;
+
+    std::mutex mutex_;
+    std::vector<ChunkSectionModels*> free_;
+};
@@ -0,0 +1,125 @@
+/*================================================================
+Filename: ChunkSectionSnapshot.h
+Date: 2018.2.13
+Created by AirGuanZ
+================================================================*/
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+
+#include <Utility/Math.h>
+
+#include <Block/Block.h>
+#include "BlockAccessor.h"
+#include "Chunk.h"
+
+constexpr int SECTION_SNAPSHOT_SIZE = CHUNK_SECTION_SIZE + 2;
+constexpr int SECTION_SNAPSHOT_BLOCK_NUM = SECTION_SNAPSHOT_SIZE * SECTION_SNAPSHOT_SIZE * SECTION_SNAPSHOT_SIZE;
+
+//截图中相邻方块的下标差，存放顺序是[x][z][y]
+constexpr int SECTION_SNAPSHOT_STRIDE_X = SECTION_SNAPSHOT_SIZE * SECTION_SNAPSHOT_SIZE;
+constexpr int SECTION_SNAPSHOT_STRIDE_Z = SECTION_SNAPSHOT_SIZE;
+constexpr int SECTION_SNAPSHOT_STRIDE_Y = 1;
+
+/*
+截图中以某个方块为中心的3x3x3邻域，直接指向截图的数据，不做拷贝
+    blks(i, j, k)对应偏移(i - 1, j - 1, k - 1)的方块
+*/
+class BlockNeighbourhood
+{
+public:
+    explicit BlockNeighbourhood(const Block *centre)
+        : centre_(centre)
+    {
+
+    }
+
+    const Block &operator()(int i, int j, int k) const
+    {
+        assert(0 <= i && i < 3 && 0 <= j && j < 3 && 0 <= k && k < 3);
+        return centre_[(i - 1) * SECTION_SNAPSHOT_STRIDE_X +
+                       (j - 1) * SECTION_SNAPSHOT_STRIDE_Y +
+                       (k - 1) * SECTION_SNAPSHOT_STRIDE_Z];
+    }
+
+private:
+    const Block *centre_;
+};
+
+/*
+一个section连同外面一圈方块的拷贝，边长18，所有创建section模型的路径都从它开始
+    在主线程截取时，之后就和区块无关了，可以交给加载线程创建模型，
+    主线程此后对区块的修改不会影响它
+    内存连续，相邻方块的下标差是常数，建模时不需要再查区块
+
+坐标是section内的局部坐标，取值范围[-1, CHUNK_SECTION_SIZE]
+*/
+class ChunkSectionSnapshot
+{
+public:
+    ChunkSectionSnapshot(const IntVector3 &sectionPos)
+        : sectionPos_(sectionPos)
+    {
+
+    }
+
+    void Capture(BlockAccessor &acc)
+    {
+        int xBase = ChunkXZ_To_BlockXZ(sectionPos_.x) - 1;
+        int yBase = ChunkSectionIndex_To_BlockY(sectionPos_.y) - 1;
+        int zBase = ChunkXZ_To_BlockXZ(sectionPos_.z) - 1;
+
+        //y方向在世界上下边界以外的部分
+        int yBegin = (std::max)(0, -yBase);
+        int yEnd = (std::min)(SECTION_SNAPSHOT_SIZE, CHUNK_MAX_HEIGHT - yBase);
+        const Block outside = { BlockType::Air, LIGHT_ALL_MAX };
+
+        //每一列只查一次区块
+        Block *blk = blocks_;
+        for(int x = 0; x != SECTION_SNAPSHOT_SIZE; ++x)
+        {
+            for(int z = 0; z != SECTION_SNAPSHOT_SIZE; ++z, blk += SECTION_SNAPSHOT_SIZE)
+            {
+                int inX, inZ;
+                const Chunk *ck = acc.GetChunk(xBase + x, zBase + z, inX, inZ);
+                if(!ck)
+                {
+                    std::fill_n(blk, SECTION_SNAPSHOT_SIZE, outside);
+                    continue;
+                }
+
+                std::fill_n(blk, yBegin, outside);
+                for(int y = yBegin; y < yEnd; ++y)
+                    blk[y] = ck->GetBlock(inX, yBase + y, inZ);
+                std::fill(blk + yEnd, blk + SECTION_SNAPSHOT_SIZE, outside);
+            }
+        }
+    }
+
+    const Block &GetBlock(int x, int y, int z) const
+    {
+        assert(-1 <= x && x <= CHUNK_SECTION_SIZE);
+        assert(-1 <= y && y <= CHUNK_SECTION_SIZE);
+        assert(-1 <= z && z <= CHUNK_SECTION_SIZE);
+        return blocks_[((x + 1) * SECTION_SNAPSHOT_SIZE + (z + 1)) * SECTION_SNAPSHOT_SIZE + (y + 1)];
+    }
+
+    BlockNeighbourhood GetNeighbourhood(int x, int y, int z) const
+    {
+        assert(0 <= x && x < CHUNK_SECTION_SIZE);
+        assert(0 <= y && y < CHUNK_SECTION_SIZE);
+        assert(0 <= z && z < CHUNK_SECTION_SIZE);
+        return BlockNeighbourhood(&GetBlock(x, y, z));
+    }
+
+    //(区块x, section下标, 区块z)
+    const IntVector3 &GetSectionPosition(void) const
+    {
+        return sectionPos_;
+    }
+
+private:
+    IntVector3 sectionPos_;
+    Block blocks_[SECTION_SNAPSHOT_BLOCK_NUM];
+};
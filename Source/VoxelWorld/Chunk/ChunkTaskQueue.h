@@ -0,0 +1,227 @@
+/*================================================================
+Filename: ChunkTaskQueue.h
+Date: 2018.2.12
+Created by AirGuanZ
+================================================================*/
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <unordered_set>
+#include <vector>
+
+#include <Utility/HelperFunctions.h>
+#include <Utility/Math.h>
+#include <Utility/Uncopiable.h>
+
+/*
+按到中心区块的切比雪夫距离（环号）分桶的任务队列，Pop总是取出离当前中心最近的任务
+    每个任务记下入桶时的中心版本号，移动中心只是把版本号加一，复杂度O(1)
+    Pop时才把过期的任务按新中心重新分桶，超出maxRing的任务直接删掉
+
+    drift_是“所有任务都是最新的”之后中心累计移动的切比雪夫距离，
+    过期任务的真实环号至多比它所在的桶小drift_，所以只需刷新[lowest, lowest + drift_]
+    这几个桶，就能保证取出的是最近的任务
+
+TaskType需要有IntVectorXZ GetPosition(void)，队列持有任务，丢弃时delete
+不是线程安全的
+*/
+template<typename TaskType>
+class ChunkTaskQueue : public Uncopiable
+{
+public:
+    ChunkTaskQueue(int maxRing)
+        : maxRing_(maxRing), centre_(0, 0), epoch_(0), drift_(0), staleCnt_(0), lowest_(0),
+          buckets_(maxRing + 1)
+    {
+        assert(maxRing >= 0);
+    }
+
+    ~ChunkTaskQueue(void)
+    {
+        Clear();
+    }
+
+    bool Empty(void) const
+    {
+        return keys_.empty();
+    }
+
+    size_t Size(void) const
+    {
+        return keys_.size();
+    }
+
+    bool Exists(const IntVectorXZ &pos) const
+    {
+        return keys_.find(pos) != keys_.end();
+    }
+
+    IntVectorXZ GetCentre(void) const
+    {
+        return centre_;
+    }
+
+    void SetCentre(const IntVectorXZ &centre)
+    {
+        if(centre == centre_)
+            return;
+        drift_ = static_cast<int>((std::min)(
+            static_cast<long long>(drift_) + Ring(centre_, centre), static_cast<long long>(maxRing_) + 1));
+        centre_ = centre;
+        ++epoch_;
+        staleCnt_ = keys_.size();
+        if(!staleCnt_)
+            drift_ = 0;
+    }
+
+    //超出范围的任务会被直接删除，返回false；位置已经存在时也不会加入
+    bool Push(TaskType *task)
+    {
+        assert(task != nullptr);
+        IntVectorXZ pos = task->GetPosition();
+        int ring = Ring(centre_, pos);
+        if(ring > maxRing_ || !keys_.insert(pos).second)
+        {
+            Helper::SafeDeleteObjects(task);
+            return false;
+        }
+
+        buckets_[ring].push_back({ task, epoch_ });
+        lowest_ = (std::min)(lowest_, ring);
+        return true;
+    }
+
+    //取出离当前中心最近的任务，队列空（或剩下的都出了范围）时返回nullptr
+    TaskType *Pop(void)
+    {
+        //[FindLowest(), refreshedTo]之间已经没有过期任务了
+        int refreshedTo = -1;
+        for(;;)
+        {
+            int lowest = FindLowest();
+            if(lowest > maxRing_)
+                return nullptr;
+
+            if(staleCnt_)
+            {
+                int refreshEnd = (std::min)(lowest + drift_, maxRing_);
+                for(int r = (std::max)(lowest, refreshedTo + 1); r <= refreshEnd; ++r)
+                    RefreshBucket(r);
+                refreshedTo = (std::max)(refreshedTo, refreshEnd);
+                if(!staleCnt_)
+                    drift_ = 0;
+            }
+
+            //最低的桶可能被搬空，这时要以新的最低桶为准再检查一遍
+            int b = FindLowest();
+            if(b > maxRing_)
+                return nullptr;
+            if(staleCnt_ && b + drift_ > refreshedTo && refreshedTo < maxRing_)
+                continue;
+
+            std::vector<Entry> &bucket = buckets_[b];
+            TaskType *rt = bucket.back().task;
+            bucket.pop_back();
+            keys_.erase(rt->GetPosition());
+            return rt;
+        }
+    }
+
+    template<typename FuncType>
+    void ForEach(FuncType &&func)
+    {
+        for(std::vector<Entry> &bucket : buckets_)
+        {
+            for(Entry &e : bucket)
+                func(e.task);
+        }
+    }
+
+    void Clear(void)
+    {
+        for(std::vector<Entry> &bucket : buckets_)
+        {
+            for(Entry &e : bucket)
+                Helper::SafeDeleteObjects(e.task);
+            bucket.clear();
+        }
+        keys_.clear();
+        drift_ = 0;
+        staleCnt_ = 0;
+        lowest_ = 0;
+    }
+
+private:
+    struct Entry
+    {
+        TaskType *task;
+        unsigned int epoch;
+    };
+
+    static int Ring(const IntVectorXZ &centre, const IntVectorXZ &pos)
+    {
+        long long dx = std::llabs(static_cast<long long>(pos.x) - centre.x);
+        long long dz = std::llabs(static_cast<long long>(pos.z) - centre.z);
+        long long rt = (std::max)(dx, dz);
+        return rt > 0x3FFFFFFF ? 0x3FFFFFFF : static_cast<int>(rt);
+    }
+
+    int FindLowest(void)
+    {
+        while(lowest_ <= maxRing_ && buckets_[lowest_].empty())
+            ++lowest_;
+        return lowest_;
+    }
+
+    //把桶r中的过期任务按当前中心重新分桶
+    void RefreshBucket(int r)
+    {
+        std::vector<Entry> &bucket = buckets_[r];
+        for(size_t i = 0; i < bucket.size();)
+        {
+            Entry &e = bucket[i];
+            if(e.epoch == epoch_)
+            {
+                ++i;
+                continue;
+            }
+
+            --staleCnt_;
+            e.epoch = epoch_;
+            int ring = Ring(centre_, e.task->GetPosition());
+            if(ring == r)
+            {
+                ++i;
+                continue;
+            }
+
+            Entry moved = e;
+            e = bucket.back();
+            bucket.pop_back();
+
+            if(ring > maxRing_)
+            {
+                keys_.erase(moved.task->GetPosition());
+                Helper::SafeDeleteObjects(moved.task);
+            }
+            else
+            {
+                buckets_[ring].push_back(moved);
+                lowest_ = (std::min)(lowest_, ring);
+            }
+        }
+    }
+
+    int maxRing_;
+    IntVectorXZ centre_;
+
+    unsigned int epoch_;
+    int drift_;
+    size_t staleCnt_;
+
+    int lowest_;
+    std::vector<std::vector<Entry>> buckets_;
+    std::unordered_set<IntVectorXZ, IntVectorXZHasher> keys_;
+};
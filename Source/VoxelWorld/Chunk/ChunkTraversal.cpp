@@ -9,7 +9,7 @@ SINGLETON_CLASS_DEFINITION(ChunkTraversal);
 
 ChunkTraversal::ChunkTraversal(void)
 {
-    //ʼˮƽһȦ
+    //初始化水平方向的一圈
 
     XZEdge_.reserve(CHUNK_SECTION_SIZE * CHUNK_SECTION_SIZE -
         (CHUNK_SECTION_SIZE - 2) * (CHUNK_SECTION_SIZE - 2));
@@ -24,7 +24,7 @@ ChunkTraversal::ChunkTraversal(void)
         XZEdge_.push_back({ CHUNK_SECTION_SIZE - 1, z });
     }
 
-    //ʼڲXZ
+    //初始化内部XZ坐标
 
     XZInternal_.reserve((CHUNK_SECTION_SIZE - 2) * (CHUNK_SECTION_SIZE - 2));
     for(int x = 1; x < CHUNK_SECTION_SIZE - 1; ++x)
@@ -33,8 +33,8 @@ ChunkTraversal::ChunkTraversal(void)
             XZInternal_.push_back({ x, z });
     }
 
-    //ʼһȦ
-    //ĸ棬Ȼ͵
+    //初始化外面一圈
+    //先四个侧面，然后顶面和地面
 
     for(const IntVectorXZ &e : XZEdge_)
     {
@@ -0,0 +1,231 @@
+/*================================================================
+Filename: GreedyBoxMesher.cpp
+Date: 2018.2.14
+Created by AirGuanZ
+================================================================*/
+#include <cassert>
+
+#include <Block/BlockInfoManager.h>
+#include <Block/BlockModelBuilder.h>
+#include "BasicRenderer.h"
+#include "ChunkSectionSnapshot.h"
+#include "GreedyBoxMesher.h"
+
+namespace
+{
+    struct FaceDesc
+    {
+        int normal[3];
+        //法线所在的轴，以及层内的两个轴
+        int axisN, axisA, axisB;
+        //四个顶点在单位方块中的位置，和纹理坐标的对应关系与BlockModelBuilder_BasicRenderer_Box相同
+        int corners[4][3];
+    };
+
+    //+x, -x, +y, -y, +z, -z，和BlockFace以及basicBoxTexPos[1]到[6]对应
+    const FaceDesc FACES[6] =
+    {
+        { { 1, 0, 0 },  0, 1, 2, { { 1, 0, 1 }, { 1, 1, 1 }, { 1, 1, 0 }, { 1, 0, 0 } } },
+        { { -1, 0, 0 }, 0, 1, 2, { { 0, 0, 0 }, { 0, 1, 0 }, { 0, 1, 1 }, { 0, 0, 1 } } },
+        { { 0, 1, 0 },  1, 0, 2, { { 0, 1, 1 }, { 0, 1, 0 }, { 1, 1, 0 }, { 1, 1, 1 } } },
+        { { 0, -1, 0 }, 1, 0, 2, { { 0, 0, 0 }, { 0, 0, 1 }, { 1, 0, 1 }, { 1, 0, 0 } } },
+        { { 0, 0, 1 },  2, 0, 1, { { 0, 0, 1 }, { 0, 1, 1 }, { 1, 1, 1 }, { 1, 0, 1 } } },
+        { { 0, 0, -1 }, 2, 0, 1, { { 1, 0, 0 }, { 1, 1, 0 }, { 0, 1, 0 }, { 0, 0, 0 } } },
+    };
+}
+
+void GreedyBoxMesher::Build(const ChunkSectionSnapshot &snapshot, ChunkSectionModels *models)
+{
+    assert(models != nullptr);
+    BuildVisibility(snapshot);
+    for(int face = 0; face != 6; ++face)
+        BuildFace(snapshot, face, models);
+}
+
+void GreedyBoxMesher::BuildVisibility(const ChunkSectionSnapshot &snapshot)
+{
+    constexpr int S = SECTION_SNAPSHOT_SIZE;
+    constexpr std::uint32_t INNER = ((1u << CHUNK_SECTION_SIZE) - 1) << 1;
+
+    //每种方块只查一次BlockInfo
+    BlockInfoManager &infoMgr = BlockInfoManager::GetInstance();
+    std::uint8_t isBasic[Blk2Int(BlockType::BlockTypeNum)], isBox[Blk2Int(BlockType::BlockTypeNum)];
+    for(int t = 0; t != Blk2Int(BlockType::BlockTypeNum); ++t)
+    {
+        const BlockInfo &info = infoMgr.GetBlockInfo(Int2Blk(t));
+        isBasic[t] = info.renderer == BlockRenderer::BasicRenderer ? 1 : 0;
+        isBox[t] = isBasic[t] && info.shape == BlockShape::Box ? 1 : 0;
+    }
+
+    for(int x = 0; x != S; ++x)
+    {
+        for(int z = 0; z != S; ++z)
+        {
+            const Block *column = &snapshot.GetBlock(x - 1, -1, z - 1);
+            std::uint32_t basic = 0, box = 0;
+            for(int y = 0; y != S; ++y)
+            {
+                int t = Blk2Int(column[y].type);
+                basic |= static_cast<std::uint32_t>(isBasic[t]) << y;
+                box |= static_cast<std::uint32_t>(isBox[t]) << y;
+            }
+            basic_[x][z] = basic;
+            box_[x][z] = box & INNER;
+        }
+    }
+
+    for(int x = 1; x != S - 1; ++x)
+    {
+        for(int z = 1; z != S - 1; ++z)
+        {
+            std::uint32_t box = box_[x][z], basic = basic_[x][z];
+            std::uint32_t vis[6] =
+            {
+                box & ~basic_[x + 1][z],
+                box & ~basic_[x - 1][z],
+                box & ~(basic >> 1),
+                box & ~(basic << 1),
+                box & ~basic_[x][z + 1],
+                box & ~basic_[x][z - 1],
+            };
+            for(int face = 0; face != 6; ++face)
+                visible_[face][x - 1][z - 1] = static_cast<std::uint16_t>(vis[face] >> 1);
+        }
+    }
+}
+
+void GreedyBoxMesher::BuildFace(const ChunkSectionSnapshot &snapshot, int face, ChunkSectionModels *models)
+{
+    BlockInfoManager &infoMgr = BlockInfoManager::GetInstance();
+    const FaceDesc &desc = FACES[face];
+    const int n = desc.axisN, a = desc.axisA, b = desc.axisB;
+    const IntVector3 normal = { desc.normal[0], desc.normal[1], desc.normal[2] };
+
+    auto Light = [&](const int (&p)[3], int dx, int dy, int dz) -> BlockLight
+    {
+        return snapshot.GetBlock(p[0] + dx, p[1] + dy, p[2] + dz).light;
+    };
+
+    const std::uint16_t (&visible)[CHUNK_SECTION_SIZE][CHUNK_SECTION_SIZE] = visible_[face];
+    std::uint16_t anyVisible = 0;
+    for(int x = 0; x != CHUNK_SECTION_SIZE; ++x)
+    {
+        for(int z = 0; z != CHUNK_SECTION_SIZE; ++z)
+            anyVisible |= visible[x][z];
+    }
+    if(!anyVisible)
+        return;
+
+    for(int slice = 0; slice != CHUNK_SECTION_SIZE; ++slice)
+    {
+        //y方向的层可以直接从列掩码中看出是否为空
+        if(n == 1 && !(anyVisible & (1 << slice)))
+            continue;
+
+        //求出这一层每个面的可见性、纹理和顶点光照
+        int p[3];
+        p[n] = slice;
+        for(int i = 0; i != CHUNK_SECTION_SIZE; ++i)
+        {
+            p[a] = i;
+            for(int j = 0; j != CHUNK_SECTION_SIZE; ++j)
+            {
+                p[b] = j;
+                FaceCell &cell = mask_[i][j];
+                cell.tex = -1;
+                cell.used = false;
+
+                if(!((visible[p[0]][p[2]] >> p[1]) & 1))
+                    continue;
+
+                const Block &blk = snapshot.GetBlock(p[0], p[1], p[2]);
+                const BlockInfo &info = infoMgr.GetBlockInfo(blk.type);
+                assert(infoMgr.IsFaceVisible(blk.type,
+                    snapshot.GetBlock(p[0] + normal.x, p[1] + normal.y, p[2] + normal.z).type,
+                    { 0, 0, 0 }, normal));
+
+                cell.tex = info.basicBoxTexPos[face + 1];
+                cell.page = info.basicBoxTexPos[0];
+
+                //顶点光照取法线一侧、围绕该顶点的四个格子
+                for(int k = 0; k != 4; ++k)
+                {
+                    int q[3] = { p[0] + normal.x, p[1] + normal.y, p[2] + normal.z };
+                    int ta = desc.corners[k][a] - 1, tb = desc.corners[k][b] - 1;
+                    std::uint32_t sum = 0;
+                    for(int da = 0; da != 2; ++da)
+                    {
+                        for(int db = 0; db != 2; ++db)
+                        {
+                            int d[3] = { 0, 0, 0 };
+                            d[a] = ta + da;
+                            d[b] = tb + db;
+                            sum += SpreadBlockLight(Light(q, d[0], d[1], d[2]));
+                        }
+                    }
+                    cell.corners[k] = sum;
+                }
+                cell.uniform = cell.corners[0] == cell.corners[1] &&
+                               cell.corners[0] == cell.corners[2] &&
+                               cell.corners[0] == cell.corners[3];
+            }
+        }
+
+        auto SameFace = [&](const FaceCell &lhs, const FaceCell &rhs)
+        {
+            return !rhs.used && rhs.tex == lhs.tex && rhs.page == lhs.page &&
+                   rhs.uniform && rhs.corners[0] == lhs.corners[0];
+        };
+
+        //从左下角开始，先沿a方向扩展，再整行沿b方向扩展
+        for(int j = 0; j != CHUNK_SECTION_SIZE; ++j)
+        {
+            for(int i = 0; i != CHUNK_SECTION_SIZE; ++i)
+            {
+                const FaceCell &cell = mask_[i][j];
+                if(cell.tex < 0 || cell.used)
+                    continue;
+
+                int w = 1, h = 1;
+                if(cell.uniform)
+                {
+                    while(i + w < CHUNK_SECTION_SIZE && SameFace(cell, mask_[i + w][j]))
+                        ++w;
+                    for(; j + h < CHUNK_SECTION_SIZE; ++h)
+                    {
+                        int k = 0;
+                        while(k < w && SameFace(cell, mask_[i + k][j + h]))
+                            ++k;
+                        if(k < w)
+                            break;
+                    }
+                }
+                for(int di = 0; di != w; ++di)
+                {
+                    for(int dj = 0; dj != h; ++dj)
+                        mask_[i + di][j + dj].used = true;
+                }
+
+                //输出矩形，纹理坐标以方块为单位，U沿顶点0到3，V沿顶点1到0
+                int origin[3];
+                origin[n] = slice; origin[a] = i; origin[b] = j;
+                int extent[3];
+                extent[n] = 1; extent[a] = w; extent[b] = h;
+
+                int uAxis = desc.corners[3][a] != desc.corners[0][a] ? a : b;
+                int vAxis = uAxis == a ? b : a;
+                const int texCoords[4][2] = { { 0, extent[vAxis] }, { 0, 0 }, { extent[uAxis], 0 }, { extent[uAxis], extent[vAxis] } };
+
+                BasicModel &model = models->basic[cell.page];
+                for(int k = 0; k != 4; ++k)
+                {
+                    IntVector3 pos = { origin[0] + desc.corners[k][0] * extent[0],
+                                       origin[1] + desc.corners[k][1] * extent[1],
+                                       origin[2] + desc.corners[k][2] * extent[2] };
+                    model.AddVertex(PackBasicVertex(pos, texCoords[k][0], texCoords[k][1],
+                                                    face, cell.tex, cell.corners[k]));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,62 @@
+/*================================================================
+Filename: GreedyBoxMesher.h
+Date: 2018.2.14
+Created by AirGuanZ
+================================================================*/
+#pragma once
+
+#include <cstdint>
+
+#include <Utility/Uncopiable.h>
+
+#include "Chunk.h"
+#include "ChunkSectionSnapshot.h"
+
+/*
+BasicRenderer的Box方块的贪心合并
+    对六个朝向的每一层，先求出这一层16x16个面的可见性、纹理和四个顶点的光照，
+    再从左下角开始尽量向两个方向扩展，把纹理相同、光照处处相同的面合并成一个矩形
+    四个顶点光照不完全相同的面（有AO渐变）不参与合并，单独输出
+
+合并后的矩形在纹理上需要重复，所以顶点的texCoord是以方块为单位的局部坐标，
+由像素着色器用frac把坐标折回纹理所在的那一格之内
+
+面的可见性用位运算一次求出：
+    截图的每一列（固定x、z，沿y的18格）压成一个整数，第y位表示该格是否为BasicRenderer
+    Box面可见当且仅当自己是BasicRenderer的Box、而法线方向的邻居不是BasicRenderer，
+    这和IsFaceVisible对BasicRenderer方块的判断相同（邻居为Null、Carve、TransLiquid时都可见），
+    所以y方向是box & ~(basic >> 1)，x、z方向是box & ~(相邻一列的basic)
+    之后只有可见的位才需要计算纹理和顶点光照
+*/
+class GreedyBoxMesher : public Uncopiable
+{
+public:
+    void Build(const ChunkSectionSnapshot &snapshot, ChunkSectionModels *models);
+
+private:
+    struct FaceCell
+    {
+        //没有可见的面时为-1
+        int tex;
+        //纹理所在的BasicModel
+        int page;
+        //四个顶点周围四个格子SpreadBlockLight之和
+        std::uint32_t corners[4];
+        //四个顶点的光照是否相同，只有相同的才能合并
+        bool uniform;
+        bool used;
+    };
+
+    void BuildVisibility(const ChunkSectionSnapshot &snapshot);
+
+    void BuildFace(const ChunkSectionSnapshot &snapshot, int face, ChunkSectionModels *models);
+
+    FaceCell mask_[CHUNK_SECTION_SIZE][CHUNK_SECTION_SIZE];
+
+    //截图中每一列哪些格子是BasicRenderer，下标为[x + 1][z + 1]，第y + 1位对应局部坐标y
+    std::uint32_t basic_[SECTION_SNAPSHOT_SIZE][SECTION_SNAPSHOT_SIZE];
+    std::uint32_t box_[SECTION_SNAPSHOT_SIZE][SECTION_SNAPSHOT_SIZE];
+
+    //每个朝向每一列的可见面，下标为[face][x][z]，第y位对应局部坐标y
+    std::uint16_t visible_[6][CHUNK_SECTION_SIZE][CHUNK_SECTION_SIZE];
+};
@@ -0,0 +1,162 @@
+/*================================================================
+Filename: LightUpdater.cpp
+Date: 2018.2.13
+Created by AirGuanZ
+================================================================*/
+#include <chrono>
+
+#include <Block/BlockInfoManager.h>
+#include "ChunkManager.h"
+#include "LightUpdater.h"
+
+namespace
+{
+    //R、G、B、天光在BlockLight中的位置
+    constexpr int LIGHT_CHANNEL_SHIFTS[] = { 12, 8, 4, 0 };
+
+    const IntVector3 NEIGHBOUR_OFFSETS[6] =
+    {
+        { 1, 0, 0 }, { -1, 0, 0 },
+        { 0, 1, 0 }, { 0, -1, 0 },
+        { 0, 0, 1 }, { 0, 0, -1 }
+    };
+
+    inline std::uint8_t GetChannel(BlockLight light, int shift)
+    {
+        return static_cast<std::uint8_t>((light >> shift) & 0x0F);
+    }
+
+    inline BlockLight SetChannel(BlockLight light, int shift, std::uint8_t value)
+    {
+        return static_cast<BlockLight>((light & ~(0x0F << shift)) | (value << shift));
+    }
+
+    //格子自身在某个通道上的发光强度，天光在高度图以上的格子为最大值
+    inline std::uint8_t GetEmission(Chunk *ck, int inX, int y, int inZ, int shift)
+    {
+        if(shift == 0)
+            return y > ck->GetHeight(inX, inZ) ? LIGHT_COMPONENT_MAX : LIGHT_COMPONENT_MIN;
+
+        const IntVector3 &emission = BlockInfoManager::GetInstance().GetBlockInfo(
+            ck->GetBlockType(inX, y, inZ)).lightEmission;
+        return static_cast<std::uint8_t>(shift == 12 ? emission.x : (shift == 8 ? emission.y : emission.z));
+    }
+}
+
+void LightUpdater::Update(ChunkManager *ckMgr, const std::vector<IntVector3> &changed,
+                          std::vector<IntVector3> &changedOutput)
+{
+    assert(ckMgr != nullptr);
+    auto start = std::chrono::steady_clock::now();
+
+    stats_ = { };
+    BlockAccessor acc(ckMgr, true);
+    for(int shift : LIGHT_CHANNEL_SHIFTS)
+        UpdateChannel(acc, changed, shift, changedOutput);
+
+    stats_.milliseconds = std::chrono::duration<float, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+void LightUpdater::UpdateChannel(BlockAccessor &acc, const std::vector<IntVector3> &changed,
+                                 int shift, std::vector<IntVector3> &changedOutput)
+{
+    const BlockInfoManager &infoMgr = BlockInfoManager::GetInstance();
+
+    removeQueue_.clear();
+    addQueue_.clear();
+
+    //没加载的区块和世界上下边界以外都当作不存在
+    auto Access = [&](const IntVector3 &p, Chunk *&ck, int &inX, int &inZ) -> bool
+    {
+        if(p.y < 0 || p.y >= CHUNK_MAX_HEIGHT)
+            return false;
+        ck = acc.GetChunk(p.x, p.z, inX, inZ);
+        return ck != nullptr;
+    };
+
+    auto SetLight = [&](Chunk *ck, int inX, const IntVector3 &p, int inZ, std::uint8_t value)
+    {
+        ck->SetBlockLight(inX, p.y, inZ, SetChannel(ck->GetBlockLight(inX, p.y, inZ), shift, value));
+        changedOutput.push_back(p);
+        ++stats_.changed;
+    };
+
+    Chunk *ck; int inX, inZ;
+
+    //删除：从变化处开始，把所有比来源暗的光照清零
+    for(const IntVector3 &p : changed)
+    {
+        if(!Access(p, ck, inX, inZ))
+            continue;
+        std::uint8_t old = GetChannel(ck->GetBlockLight(inX, p.y, inZ), shift);
+        if(old != LIGHT_COMPONENT_MIN)
+        {
+            SetLight(ck, inX, p, inZ, LIGHT_COMPONENT_MIN);
+            ++stats_.removed;
+        }
+        removeQueue_.push_back({ p, old });
+    }
+
+    for(size_t i = 0; i < removeQueue_.size(); ++i)
+    {
+        RemoveNode node = removeQueue_[i];
+        for(const IntVector3 &d : NEIGHBOUR_OFFSETS)
+        {
+            IntVector3 n = node.pos + d;
+            if(!Access(n, ck, inX, inZ))
+                continue;
+
+            std::uint8_t nLight = GetChannel(ck->GetBlockLight(inX, n.y, inZ), shift);
+            if(nLight == LIGHT_COMPONENT_MIN)
+                continue;
+
+            if(nLight < node.light)
+            {
+                SetLight(ck, inX, n, inZ, LIGHT_COMPONENT_MIN);
+                ++stats_.removed;
+                removeQueue_.push_back({ n, nLight });
+            }
+            else //有别的来源，作为重新传播的起点
+                addQueue_.push_back(n);
+        }
+    }
+
+    //变化处和被清零的格子中自身发光的，也是重新传播的起点
+    for(const RemoveNode &node : removeQueue_)
+    {
+        if(!Access(node.pos, ck, inX, inZ))
+            continue;
+        std::uint8_t emission = GetEmission(ck, inX, node.pos.y, inZ, shift);
+        if(emission > GetChannel(ck->GetBlockLight(inX, node.pos.y, inZ), shift))
+        {
+            SetLight(ck, inX, node.pos, inZ, emission);
+            addQueue_.push_back(node.pos);
+        }
+    }
+
+    //重新传播：只在能让邻居变亮时更新
+    for(size_t i = 0; i < addQueue_.size(); ++i)
+    {
+        IntVector3 p = addQueue_[i];
+        ++stats_.propagated;
+
+        if(!Access(p, ck, inX, inZ))
+            continue;
+        int light = GetChannel(ck->GetBlockLight(inX, p.y, inZ), shift);
+
+        for(const IntVector3 &d : NEIGHBOUR_OFFSETS)
+        {
+            IntVector3 n = p + d;
+            if(!Access(n, ck, inX, inZ))
+                continue;
+
+            int newLight = light - infoMgr.GetBlockInfo(ck->GetBlockType(inX, n.y, inZ)).lightDec;
+            if(newLight > GetChannel(ck->GetBlockLight(inX, n.y, inZ), shift))
+            {
+                SetLight(ck, inX, n, inZ, static_cast<std::uint8_t>(newLight));
+                addQueue_.push_back(n);
+            }
+        }
+    }
+}
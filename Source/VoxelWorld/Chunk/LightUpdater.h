@@ -0,0 +1,72 @@
+/*================================================================
+Filename: LightUpdater.h
+Date: 2018.2.13
+Created by AirGuanZ
+================================================================*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <Utility/Math.h>
+#include <Utility/Uncopiable.h>
+
+#include <Block/Block.h>
+#include "BlockAccessor.h"
+
+class ChunkManager;
+
+//一次光照更新做了多少工作，用于性能测试
+struct LightUpdateStats
+{
+    //删除阶段被清零的格子数（四个通道分别计）
+    size_t removed;
+    //重新传播阶段从队列中取出的格子数
+    size_t propagated;
+    //光照值发生了变化的次数（去重前）
+    size_t changed;
+    //总耗时（毫秒）
+    float milliseconds;
+};
+
+/*
+方块修改后的光照增量更新，R、G、B、天光四个通道分别进行
+    1. 删除：把变化处的旧光照清零，沿着光照严格递减的方向把可能来自它的光照都清零，
+       遇到不比它暗的格子就记下来，作为第二步的光源
+    2. 重新传播：从第一步记下的格子以及自身发光的格子出发做BFS，只在能变亮时更新
+
+所有方块的lightDec都至少为1，所以删除阶段每个格子每个通道至多清零一次，
+传播阶段每个格子每个通道至多被更新LIGHT_COMPONENT_MAX次
+
+只处理已经加载的区块，传播到没加载的区块就停下
+*/
+class LightUpdater : public Uncopiable
+{
+public:
+    //changed中的方块发生了改变（方块类型或者天光来源），更新受影响的光照
+    //光照发生了变化的位置会追加到changedOutput中
+    void Update(ChunkManager *ckMgr, const std::vector<IntVector3> &changed,
+                std::vector<IntVector3> &changedOutput);
+
+    //最近一次Update的统计
+    const LightUpdateStats &GetStats(void) const
+    {
+        return stats_;
+    }
+
+private:
+    struct RemoveNode
+    {
+        IntVector3 pos;
+        std::uint8_t light;
+    };
+
+    void UpdateChannel(BlockAccessor &acc, const std::vector<IntVector3> &changed,
+                       int shift, std::vector<IntVector3> &changedOutput);
+
+    std::vector<RemoveNode> removeQueue_;
+    std::vector<IntVector3> addQueue_;
+
+    LightUpdateStats stats_ = { };
+};
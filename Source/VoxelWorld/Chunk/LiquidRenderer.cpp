@@ -20,8 +20,44 @@ LiquidRenderer::~LiquidRenderer(void)
 
 bool LiquidRenderer::Initialize(std::string &errMsg)
 {
-    if(!basic_.Initialize(errMsg))
+    errMsg = "";
+    ID3D11Device *dev = Window::GetInstance().GetD3DDevice();
+
+    std::string vsSrc, psSrc;
+    if(!Helper::ReadFile(LIQUID_RENDERER_VERTEX_SHADER, vsSrc) ||
+       !Helper::ReadFile(LIQUID_RENDERER_PIXEL_SHADER, psSrc))
+    {
+        errMsg = "Failed to load shader source for liquid renderer";
+        return false;
+    }
+
+    if(!shader_.InitStage<SS_VS>(dev, vsSrc, &errMsg) ||
+       !shader_.InitStage<SS_PS>(dev, psSrc, &errMsg))
+    {
+        Destroy();
         return false;
+    }
+
+    D3D11_INPUT_ELEMENT_DESC inputLayoutDesc[] =
+    {
+        { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0,
+            Helper::MemOffset(&Vertex::pos), D3D11_INPUT_PER_VERTEX_DATA, 0 },
+        { "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0,
+            Helper::MemOffset(&Vertex::texCoord), D3D11_INPUT_PER_VERTEX_DATA, 0 },
+        { "LIGHTCOLOR", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0,
+            Helper::MemOffset(&Vertex::lightColor), D3D11_INPUT_PER_VERTEX_DATA, 0 },
+        { "SUNLIGHT", 0, DXGI_FORMAT_R32_FLOAT, 0,
+            Helper::MemOffset(&Vertex::sunlight), D3D11_INPUT_PER_VERTEX_DATA, 0 }
+    };
+    inputLayout_.Initialize(
+        inputLayoutDesc, static_cast<int>(Helper::ArraySize(inputLayoutDesc)),
+        shader_.GetShaderByteCodeWithInputSignature(),
+        shader_.GetShaderByteCodeSizeWithInputSignature());
+    if(!inputLayout_)
+    {
+        Destroy();
+        return false;
+    }
 
     raster_ = std::make_unique<RasterState>(D3D11_FILL_SOLID, D3D11_CULL_NONE);
     blend_  = std::make_unique<BlendState>();
@@ -38,7 +74,8 @@ bool LiquidRenderer::Initialize(std::string &errMsg)
 
 void LiquidRenderer::Destroy(void)
 {
-    basic_.Destroy();
+    inputLayout_.Destroy();
+    shader_.Destroy();
     blend_.reset();
     raster_.reset();
     depth_.reset();
@@ -46,14 +83,15 @@ void LiquidRenderer::Destroy(void)
 
 bool LiquidRenderer::IsAvailable(void) const
 {
-    return basic_.IsAvailable();
+    return inputLayout_.IsAvailable();
 }
 
 void LiquidRenderer::Begin(void)
 {
     ID3D11DeviceContext *DC = Window::GetInstance().GetD3DDeviceContext();
 
-    basic_.Begin();
+    shader_.Bind(DC);
+    DC->IASetInputLayout(inputLayout_);
     DC->OMSetBlendState(*blend_, nullptr, 0xFFFFFFFF);
     DC->RSSetState(*raster_);
     DC->OMSetDepthStencilState(*depth_, 0);
@@ -66,10 +104,11 @@ void LiquidRenderer::End(void)
     DC->OMSetBlendState(nullptr, nullptr, 0xFFFFFFFF);
     DC->RSSetState(nullptr);
     DC->OMSetDepthStencilState(nullptr, 0);
-    basic_.End();
+    shader_.Unbind(DC);
+    DC->IASetInputLayout(nullptr);
 }
 
 LiquidRenderer::ShaderType &LiquidRenderer::GetShader(void)
 {
-    return basic_.GetShader();
+    return shader_;
 }
@@ -16,8 +16,9 @@ Created by AirGuanZ
 
 #include <D3DObject/BlendState.h>
 #include <D3DObject/DepthStencilState.h>
+#include <D3DObject/InputLayout.h>
 #include <D3DObject/RasterState.h>
-#include "BasicRenderer.h"
+#include "CarveRenderer.h"
 
 constexpr int LIQUID_RENDERER_TEXTURE_NUM = 1;
 constexpr int LIQUID_RENDERER_TEXTURE_BLOCK_SIZE = 16;
@@ -28,7 +29,7 @@ public:
     using ShaderType = OWE::Shader<SS_VS, SS_PS>;
     using Uniforms = OWE::ShaderUniforms<SS_VS, SS_PS>;
 
-    using Vertex = typename BasicRenderer::Vertex;
+    using Vertex = typename CarveRenderer::Vertex;
 
     LiquidRenderer(void);
     ~LiquidRenderer(void);
@@ -43,7 +44,8 @@ public:
     ShaderType &GetShader(void);
 
 private:
-    BasicRenderer basic_;
+    InputLayout inputLayout_;
+    ShaderType shader_;
 
     std::unique_ptr<BlendState> blend_;
     std::unique_ptr<RasterState> raster_;
@@ -0,0 +1,240 @@
+/*================================================================
+Filename: PalettedArray.h
+Date: 2018.2.10
+Created by AirGuanZ
+================================================================*/
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/*
+调色板压缩的定长数组
+    每个元素只存一个调色板下标，下标按bits_位紧密排列在64位字中
+    bits_只取0, 1, 2, 4, 8, 16，这样一个下标永远不会跨字
+    bits_为0表示所有元素相同（uniform），此时不分配下标数组，第一次写入不同的值时才真正分配
+    调色板放不下新值时自动加宽下标（重新打包），Compact可以去掉不再使用的调色板项，
+    必要时退化回uniform
+
+写入时用一张直接映射的小表从值找调色板下标：按值的哈希取一格，格子里记着上次落在这里的下标，
+    对上了就不用扫描调色板，对不上再线性查找并更新这一格
+    光照section里常有几十种不同的值，这样逐格写光照时基本不需要扫描
+
+T必须可以用==比较、可以用std::hash求哈希，且调色板项数不超过2^16
+*/
+template<typename T, int N>
+class PalettedArray
+{
+    static_assert(N > 0 && N % 64 == 0, "PalettedArray: N must be a multiple of 64");
+
+public:
+    using Value = T;
+    static constexpr int SIZE = N;
+
+    PalettedArray(const T &initValue = T())
+    {
+        Fill(initValue);
+    }
+
+    //把所有元素设为同一个值，并释放多余的空间
+    void Fill(const T &value)
+    {
+        std::vector<T>(1, value).swap(palette_);
+        bits_ = 0;
+        std::vector<std::uint64_t>().swap(data_);
+        ClearLookup();
+    }
+
+    T Get(int idx) const
+    {
+        assert(0 <= idx && idx < N);
+        if(!bits_)
+            return palette_[0];
+        return palette_[GetIndex(idx)];
+    }
+
+    void Set(int idx, const T &value)
+    {
+        assert(0 <= idx && idx < N);
+        if(!bits_ && value == palette_[0])
+            return;
+        SetIndex(idx, FindOrAddPalette(value));
+    }
+
+    bool IsUniform(void) const
+    {
+        return !bits_;
+    }
+
+    //仅在IsUniform()为true时有意义
+    const T &GetUniformValue(void) const
+    {
+        assert(IsUniform());
+        return palette_[0];
+    }
+
+    //调色板中是否有满足pred的值
+    //没有Compact过的调色板里可能留有已经不用的值，此时结果偏保守
+    template<typename Pred>
+    bool AnyInPalette(Pred &&pred) const
+    {
+        for(const T &value : palette_)
+        {
+            if(pred(value))
+                return true;
+        }
+        return false;
+    }
+
+    //去掉不再被引用的调色板项，必要时收窄下标宽度
+    void Compact(void)
+    {
+        if(!bits_)
+            return;
+
+        std::vector<std::uint32_t> remap(palette_.size(), UNUSED_INDEX);
+        std::vector<T> newPalette;
+        for(int i = 0; i != N; ++i)
+        {
+            std::uint32_t old = GetIndex(i);
+            if(remap[old] == UNUSED_INDEX)
+            {
+                remap[old] = static_cast<std::uint32_t>(newPalette.size());
+                newPalette.push_back(palette_[old]);
+            }
+        }
+
+        int newBits = BitsFor(newPalette.size());
+        std::vector<std::uint64_t> newData(WordCount(newBits), 0);
+        if(newBits)
+        {
+            for(int i = 0; i != N; ++i)
+                WriteIndex(newData, newBits, i, remap[GetIndex(i)]);
+        }
+
+        palette_.swap(newPalette);
+        palette_.shrink_to_fit();
+        data_.swap(newData);
+        bits_ = newBits;
+        ClearLookup();
+    }
+
+    int GetPaletteSize(void) const
+    {
+        return static_cast<int>(palette_.size());
+    }
+
+    int GetBitsPerEntry(void) const
+    {
+        return bits_;
+    }
+
+    //近似的堆内存占用，单位为字节
+    size_t GetMemoryUsage(void) const
+    {
+        return palette_.capacity() * sizeof(T) + data_.capacity() * sizeof(std::uint64_t);
+    }
+
+private:
+    static constexpr std::uint32_t UNUSED_INDEX = 0xFFFFFFFF;
+
+    static constexpr int LOOKUP_BITS = 6;
+    static constexpr int LOOKUP_SIZE = 1 << LOOKUP_BITS;
+
+    //乘法哈希取高位，BlockLight这样低位变化少的值也能分散开
+    static int LookupSlot(const T &value)
+    {
+        std::uint32_t h = static_cast<std::uint32_t>(std::hash<T>()(value));
+        return static_cast<int>((h * 0x9E3779B9u) >> (32 - LOOKUP_BITS));
+    }
+
+    //格子里的下标只是猜测，使用前总要和调色板核对，所以清成0就行
+    void ClearLookup(void)
+    {
+        for(std::uint16_t &idx : lookup_)
+            idx = 0;
+    }
+
+    static int BitsFor(size_t paletteSize)
+    {
+        if(paletteSize <= 1)
+            return 0;
+        int bits = 1;
+        while((size_t(1) << bits) < paletteSize)
+            bits <<= 1;
+        assert(bits <= 16);
+        return bits;
+    }
+
+    static size_t WordCount(int bits)
+    {
+        return static_cast<size_t>(N) * bits / 64;
+    }
+
+    static void WriteIndex(std::vector<std::uint64_t> &data, int bits, int idx, std::uint32_t palIdx)
+    {
+        int bitPos = idx * bits;
+        std::uint64_t mask = ((std::uint64_t(1) << bits) - 1) << (bitPos & 63);
+        std::uint64_t &word = data[bitPos >> 6];
+        word = (word & ~mask) | (std::uint64_t(palIdx) << (bitPos & 63));
+    }
+
+    std::uint32_t GetIndex(int idx) const
+    {
+        int bitPos = idx * bits_;
+        return static_cast<std::uint32_t>(
+            (data_[bitPos >> 6] >> (bitPos & 63)) & ((std::uint64_t(1) << bits_) - 1));
+    }
+
+    void SetIndex(int idx, std::uint32_t palIdx)
+    {
+        WriteIndex(data_, bits_, idx, palIdx);
+    }
+
+    std::uint32_t FindOrAddPalette(const T &value)
+    {
+        std::uint16_t &slot = lookup_[LookupSlot(value)];
+        if(palette_[slot] == value)
+            return slot;
+
+        std::uint32_t palSize = static_cast<std::uint32_t>(palette_.size());
+        for(std::uint32_t i = 0; i != palSize; ++i)
+        {
+            if(palette_[i] == value)
+            {
+                slot = static_cast<std::uint16_t>(i);
+                return i;
+            }
+        }
+
+        palette_.push_back(value);
+        if(palette_.size() > (size_t(1) << bits_))
+            Repack(bits_ ? (bits_ << 1) : 1);
+
+        slot = static_cast<std::uint16_t>(palSize);
+        return palSize;
+    }
+
+    void Repack(int newBits)
+    {
+        assert(newBits > bits_ && newBits <= 16);
+        std::vector<std::uint64_t> newData(WordCount(newBits), 0);
+        if(bits_)
+        {
+            for(int i = 0; i != N; ++i)
+                WriteIndex(newData, newBits, i, GetIndex(i));
+        }
+        data_.swap(newData);
+        bits_ = newBits;
+    }
+
+    std::vector<T> palette_;
+    std::vector<std::uint64_t> data_;
+    int bits_;
+
+    //值的哈希到调色板下标，见类前的说明
+    std::uint16_t lookup_[LOOKUP_SIZE];
+};
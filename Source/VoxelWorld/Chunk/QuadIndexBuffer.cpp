@@ -0,0 +1,98 @@
+/*================================================================
+Filename: QuadIndexBuffer.cpp
+Date: 2018.2.15
+Created by AirGuanZ
+================================================================*/
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include <Utility/HelperFunctions.h>
+
+#include <Window/Window.h>
+#include "Chunk.h"
+#include "QuadIndexBuffer.h"
+
+SINGLETON_CLASS_DEFINITION(QuadIndexBuffer);
+
+namespace
+{
+    constexpr size_t MAX_VERTEX_NUM_16 = 65536;
+    constexpr size_t MAX_VERTEX_NUM_32 = CHUNK_SECTION_SIZE * CHUNK_SECTION_SIZE * CHUNK_SECTION_SIZE * 6 * 4;
+
+    template<typename IndexType>
+    ID3D11Buffer *CreateQuadIndexBuffer(size_t vertexCount)
+    {
+        std::vector<IndexType> indices;
+        indices.reserve(QuadIndexBuffer::GetIndexCount(vertexCount));
+        for(size_t v = 0; v + 4 <= vertexCount; v += 4)
+        {
+            IndexType i = static_cast<IndexType>(v);
+            indices.push_back(i);
+            indices.push_back(i + 1);
+            indices.push_back(i + 2);
+
+            indices.push_back(i);
+            indices.push_back(i + 2);
+            indices.push_back(i + 3);
+        }
+
+        D3D11_BUFFER_DESC dc;
+        dc.BindFlags = D3D11_BIND_INDEX_BUFFER;
+        dc.ByteWidth = static_cast<UINT>(indices.size() * sizeof(IndexType));
+        dc.CPUAccessFlags = 0;
+        dc.MiscFlags = 0;
+        dc.StructureByteStride = 0;
+        dc.Usage = D3D11_USAGE_IMMUTABLE;
+
+        D3D11_SUBRESOURCE_DATA data = { indices.data(), 0, 0 };
+
+        ID3D11Buffer *rt = nullptr;
+        HRESULT hr = Window::GetInstance().GetD3DDevice()->CreateBuffer(&dc, &data, &rt);
+        return SUCCEEDED(hr) ? rt : nullptr;
+    }
+}
+
+QuadIndexBuffer::QuadIndexBuffer(void)
+    : idx16_(nullptr), idx32_(nullptr)
+{
+
+}
+
+QuadIndexBuffer::~QuadIndexBuffer(void)
+{
+    Destroy();
+}
+
+bool QuadIndexBuffer::Initialize(void)
+{
+    assert(Window::GetInstance().IsD3DAvailable());
+    Destroy();
+
+    idx16_ = CreateQuadIndexBuffer<std::uint16_t>(MAX_VERTEX_NUM_16);
+    idx32_ = CreateQuadIndexBuffer<std::uint32_t>(MAX_VERTEX_NUM_32);
+    if(!idx16_ || !idx32_)
+    {
+        Destroy();
+        return false;
+    }
+    return true;
+}
+
+void QuadIndexBuffer::Destroy(void)
+{
+    Helper::ReleaseCOMObjects(idx16_, idx32_);
+}
+
+ID3D11Buffer *QuadIndexBuffer::GetBuffer(size_t vertexCount, DXGI_FORMAT &format) const
+{
+    assert(idx16_ && idx32_);
+    assert(vertexCount % 4 == 0 && vertexCount <= MAX_VERTEX_NUM_32);
+    if(vertexCount <= MAX_VERTEX_NUM_16)
+    {
+        format = DXGI_FORMAT_R16_UINT;
+        return idx16_;
+    }
+    format = DXGI_FORMAT_R32_UINT;
+    return idx32_;
+}
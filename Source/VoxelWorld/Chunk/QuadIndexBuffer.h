@@ -0,0 +1,42 @@
+/*================================================================
+Filename: QuadIndexBuffer.h
+Date: 2018.2.15
+Created by AirGuanZ
+================================================================*/
+#pragma once
+
+#include <cstddef>
+
+#include <Utility/D3D11Header.h>
+#include <Utility/Singleton.h>
+
+/*
+所有section模型共用的四边形下标缓冲
+    模型中的顶点每四个组成一个四边形，两个三角形是(0, 1, 2)和(0, 2, 3)，
+    这样下标只和顶点数有关，模型不需要自己的下标
+    顶点数不超过65536时用16位下标，否则用32位下标，
+    32位的缓冲足够画一个section中每个方块的六个面
+
+在创建区块模型之前Initialize，之后模型只保存缓冲的指针，不持有引用
+*/
+class QuadIndexBuffer : public Singleton<QuadIndexBuffer>
+{
+public:
+    QuadIndexBuffer(void);
+    ~QuadIndexBuffer(void);
+
+    bool Initialize(void);
+    void Destroy(void);
+
+    //能绘制vertexCount个顶点的下标缓冲，format返回下标格式
+    ID3D11Buffer *GetBuffer(size_t vertexCount, DXGI_FORMAT &format) const;
+
+    static size_t GetIndexCount(size_t vertexCount)
+    {
+        return vertexCount / 4 * 6;
+    }
+
+private:
+    ID3D11Buffer *idx16_;
+    ID3D11Buffer *idx32_;
+};
@@ -6,8 +6,11 @@ Created by AirGuanZ
 #pragma once
 
 #include <iostream>
+#include <utility>
 #include <vector>
 
+#include <Utility/Math.h>
+
 #include <Chunk/Model.h>
 
 class RenderQueue
@@ -28,3 +31,28 @@ public:
 private:
     std::vector<const Model*> models_;
 };
+
+//顶点是section内局部坐标的模型，每次绘制前用它的section原点调用setOrigin
+class SectionRenderQueue
+{
+public:
+    void AddModel(const Model *model, const Vector3 &sectionOrigin)
+    {
+        if(model->IsAvailable())
+            models_.push_back({ model, sectionOrigin });
+    }
+
+    template<typename SetOriginFunc>
+    void Render(SetOriginFunc &&setOrigin)
+    {
+        for(auto &[model, origin] : models_)
+        {
+            setOrigin(origin);
+            model->Draw();
+        }
+        models_.clear();
+    }
+
+private:
+    std::vector<std::pair<const Model*, Vector3>> models_;
+};
@@ -30,19 +30,19 @@ public:
     InputManager(void);
     ~InputManager(void);
 
-    //Ƿڡѹ״̬
+    //按键是否处于“按压”的状态
     bool IsKeyDown    (int keyCode)
     {
         return kbState_.IsKeyDown(Int2Keys(keyCode));
     }
 
-    //Ƿով¡Ķ
+    //按键是否刚刚经历“按下”的动作
     bool IsKeyPressed (int keyCode)
     {
         return kbTracker_.IsKeyPressed(Int2Keys(keyCode));
     }
 
-    //ǷովͷšĶ
+    //按键是否刚刚经历“释放”的动作
     bool IsKeyReleased(int keyCode)
     {
         return kbTracker_.IsKeyReleased(Int2Keys(keyCode));
@@ -88,7 +88,7 @@ public:
         return mbReleased_[static_cast<int>(button)];
     }
 
-    //x, yǿͻ
+    //x, y是客户区坐标
     void LockCursor(bool lock, int x, int y);
 
     void LockCursor(bool lock)
@@ -103,7 +103,7 @@ public:
 
     void ShowCursor(bool show)
     {
-        //showCursor_ = show==Ϊ˸ֵ
+        //这里“showCursor_ = show”不是==，就是为了赋值
         ::ShowCursor((showCursor_ = show) ? TRUE : FALSE);
     }
 
@@ -123,15 +123,15 @@ private:
     DirectX::Keyboard::State kbState_;
     DirectX::Keyboard::KeyboardStateTracker kbTracker_;
 
-    //ϢѭҪֶmbDownwheelMov
-    //״̬¶Update
+    //消息循环需要手动设置mbDown和wheelMov
+    //其他状态更新都由Update完成
 
     int curPosX_, curPosY_;
     int curMovX_, curMovY_;
     int wheelMov_;
 
     bool curLocked_;
-    int curLockX_, curLockY_; //Ļ
+    int curLockX_, curLockY_; //存的是屏幕坐标
 
     bool mbDown_      [3];
     bool mbLast_      [3];
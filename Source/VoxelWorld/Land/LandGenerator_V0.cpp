@@ -19,10 +19,6 @@ void LandGenerator_V0::GenerateLand(Chunk *ck)
 {
     assert(ck != nullptr);
 
-    Chunk::BlockTypeData &data = ck->blocks;
-    Chunk::HeightMap &heightMap = ck->heightMap;
-    Chunk::BlockLightData &lights = ck->lights;
-
     IntVectorXZ ckPos = ck->GetPosition();
     int xBase = ChunkXZ_To_BlockXZ(ckPos.x);
     int zBase = ChunkXZ_To_BlockXZ(ckPos.z);
@@ -65,7 +61,7 @@ void LandGenerator_V0::GenerateLand(Chunk *ck)
         }
     }
 
-    //
+    //生成树
     OakGenerator_V0(seed_).Make(ck);
 
     for(int x = 0; x != CHUNK_SECTION_SIZE; ++x)
@@ -23,7 +23,7 @@ void OakGenerator_V0::Try(Chunk *ck, int x, int y, int z) const
 {
     assert(ck != nullptr);
 
-    //ϷԼ
+    //合法性检验
 
     if(((x - 3) | (CHUNK_SECTION_SIZE - 1 - (x + 3)) |
         (z - 3) | (CHUNK_SECTION_SIZE - 1 - (z + 3)) |
@@ -48,7 +48,7 @@ void OakGenerator_V0::Try(Chunk *ck, int x, int y, int z) const
         }
     }
 
-    //
+    //放置橡树方块
 
     int xBase = ck->GetXPosBase();
     int zBase = ck->GetZPosBase();
@@ -11,20 +11,20 @@ Created by AirGuanZ
 using namespace LandGenerator_V1;
 
 /*
-άŵͼʵ֣ÿһ㣨ĵȺϵĵ㣩ԼõռݵȺϵ
+基于维诺图实现，每个区块网格内随机生成一个点（这样的点称群系中心点）以及该点占据的群系类型
 
-һȺϵĵȺϵͣھĵ͵ڶĵ
-ϵλþfactorneiFactor
+一个方块的群系类型是离它最近的中心点的群系类型，它在距离最近的中心点和第二近的中心点
+连线上的位置决定了factor和neiFactor
 
-ȺϵԵĲԣھάŵͼеĶΰ
-ԺöάΪжλõƫʵ
+至于群系边缘的不规则性，现在就用维诺图中的多边形吧
+以后可以用二维随机向量场作为方块判定位置的偏移来实现
 */
 
 /*
-뾶ΪA
-ĳеķ飬ĵľ벻sqrt(2) * A
-ݴˣһĵܳ񸽽5 * 5ȥĸǵķΧڣ
-һϢӦ
+即区块网格半径为A
+对某个区块网格中的方块，它与离它最近的中心点的距离不超过sqrt(2) * A。
+据此，离一个方块最近的中心点可能出现在区块网格附近5 * 5除去四个角的范围内，
+这一信息应当被缓存下来
 */
 
 #define RESULT(X, Z) result[(X)][(Z)]
@@ -63,7 +63,7 @@ BiomeGenerator::BiomeGenerator(Seed seed)
 
 void BiomeGenerator::Generate(int ckX, int ckZ)
 {
-    //ȡgrid
+    //取得区块所在grid坐标
     auto [gridX, gridZ] = ChunkXZ_To_BiomeGridXZ({ ckX, ckZ });
     auto [rckX, rckZ]   = ChunkXZ_To_ChunkXZInBiomeGrid({ ckX, ckZ });
 
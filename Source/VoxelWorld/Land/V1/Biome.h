@@ -47,9 +47,9 @@ namespace LandGenerator_V1
     class BiomeGenerator
     {
     public:
-        //ÿˮƽ꣬ɵȺϵϢֹ
-        //ֱǱȺϵͺõһȺϵ
-        //factorneiFactor֮ӦΪ1Ⱥϵ֮ĸ߶Ȳֵ
+        //对每个水平方块坐标，生成的群系信息由两部分构成
+        //分别是本群系类型和离该点最近的另一个群系的类型
+        //factor和neiFactor之和应为1，用来做群系之间的高度插值
         struct BiomeResult
         {
             BiomeType type;
@@ -8,29 +8,32 @@ Created by AirGuanZ
 #define VW_FILENAME(X) VW_FILENAME_AUX(X)
 #define VW_FILENAME_AUX(X) L#X
 
-//Application
+//Application相关
 
 #define APPLICATION_CONFIGURE_FILE VW_FILENAME(config.txt)
 
-//BasicRenderer
+//BasicRenderer相关
 
 #define BASIC_RENDERER_VERTEX_SHADER VW_FILENAME(Bin/Shader/Basic/vertex.hlsl)
 #define BASIC_RENDERER_PIXEL_SHADER  VW_FILENAME(Bin/Shader/Basic/pixel.hlsl)
 
 #define BASIC_RENDERER_TEXTURE_0 VW_FILENAME(Bin/Texture/Basic/0.png)
 
-//CurveRenderer
+//CurveRenderer相关
 
 #define CARVE_RENDERER_VERTEX_SHADER VW_FILENAME(Bin/Shader/Carve/vertex.hlsl)
 #define CARVE_RENDERER_PIXEL_SHADER  VW_FILENAME(Bin/Shader/Carve/pixel.hlsl)
 
 #define CARVE_RENDERER_TEXTURE_0 VW_FILENAME(Bin/Texture/Carve/0.png)
 
-//LiquidRenderer
+//LiquidRenderer相关
+
+#define LIQUID_RENDERER_VERTEX_SHADER VW_FILENAME(Bin/Shader/Liquid/vertex.hlsl)
+#define LIQUID_RENDERER_PIXEL_SHADER  VW_FILENAME(Bin/Shader/Liquid/pixel.hlsl)
 
 #define LIQUID_RENDERER_TEXTURE_0 VW_FILENAME(Bin/Texture/Liquid/0.png)
 
-//ImmediateScreen2D
+//ImmediateScreen2D相关
 
 #define IMMEDIATE_SCREEN_2D_NOR_VERTEX_SHADER VW_FILENAME(Bin/Shader/ImmediateScreen2D/normalVertex.hlsl)
 #define IMMEDIATE_SCREEN_2D_NOR_PIXEL_SHADER  VW_FILENAME(Bin/Shader/ImmediateScreen2D/normalPixel.hlsl)
@@ -39,7 +42,7 @@ Created by AirGuanZ
 
 #define CROSSHAIR_BASIC_TEXTURE VW_FILENAME(Bin/Texture/Crosshair/cross.png)
 
-//ActorModel
+//ActorModel相关
 
 #define ACTOR_RENDERER_VERTEX_SHADER VW_FILENAME(Bin/Shader/Actor/vertex.hlsl)
 #define ACTOR_RENDERER_PIXEL_SHADER  VW_FILENAME(Bin/Shader/Actor/pixel.hlsl)
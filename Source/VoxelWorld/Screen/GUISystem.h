@@ -38,9 +38,9 @@ public:
     void PopFont(void);
 #endif
 
-    //¼һ˵Ϣѭ
+    //输入事件，一般来说由消息循环调用
 
-    //úҪԼãϢѭ
+    //该函数需要自己调用，消息循环不会管
     void MousePosition(int x, int y);
 
     void MouseButtonDown(MouseButton button);
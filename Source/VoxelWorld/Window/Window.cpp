@@ -27,7 +27,7 @@ namespace
     constexpr DXGI_FORMAT SWAPCHAIN_BUFFER_FORMAT    = DXGI_FORMAT_R8G8B8A8_UNORM;
     constexpr DXGI_FORMAT DEPTHSTENCIL_BUFFER_FORMAT = DXGI_FORMAT_D24_UNORM_S8_UINT;
 
-    //Win32
+    //Win32窗口
     namespace Win
     {
         HWND hWnd = NULL;
@@ -44,7 +44,7 @@ namespace
         int clientCenY   = 0;
     }
 
-    //D3D
+    //D3D上下文
     namespace D3D
     {
         IDXGISwapChain *swapChain = nullptr;
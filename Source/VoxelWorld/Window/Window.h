@@ -34,7 +34,7 @@ public:
     void ClearRenderTarget(void);
     void ClearDepthStencil(void);
 
-    //ClientCentreֵΪĻǿͻ
+    //ClientCentre返回值为屏幕坐标而非客户区坐标
 
     int ClientCentreX(void);
     int ClientCentreY(void);
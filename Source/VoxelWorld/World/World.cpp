@@ -54,7 +54,7 @@ void World::Update(float deltaT)
         BlockXZ_To_ChunkXZ(Camera_To_Block(actor_.GetCameraPosition().x)),
         BlockXZ_To_ChunkXZ(Camera_To_Block(actor_.GetCameraPosition().z)));
 
-    //ƻͷ
+    //方块破坏和放置
     Block blk; BlockFace face; IntVector3 pickPos;
     if(ckMgr_.PickBlock(actor_.GetCameraPosition(), actor_.GetCamera().GetDirection(),
         10.0f, 0.01f, IsNotAirOrWater, blk, face, pickPos))
@@ -63,7 +63,7 @@ void World::Update(float deltaT)
         {
             ckMgr_.SetBlockType(pickPos.x, pickPos.y, pickPos.z, BlockType::Air);
         }
-        else if(InputManager::GetInstance().IsMouseButtonPressed(MouseButton::Right)) //
+        else if(InputManager::GetInstance().IsMouseButtonPressed(MouseButton::Right)) //方块放置
         {
             static const IntVector3 faceDir[] =
             {
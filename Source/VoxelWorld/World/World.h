@@ -28,6 +28,11 @@ public:
         return actor_;
     }
 
+    ChunkManager &GetChunkManager(void)
+    {
+        return ckMgr_;
+    }
+
 private:
     Actor actor_;
     ChunkManager ckMgr_;
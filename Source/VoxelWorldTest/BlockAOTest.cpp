@@ -0,0 +1,38 @@
+/*================================================================
+Filename: BlockAOTest.cpp
+Date: 2018.2.20
+Created by AirGuanZ
+================================================================*/
+#include <cmath>
+#include <cstdint>
+
+#include <Block/BlockAO.h>
+
+#include "Test.h"
+
+//穷举四个格子光照分量的所有组合，检查查找表和原来的浮点算法一致
+void TestBlockAO(void)
+{
+    auto Near = [](float lhs, float rhs) { return (std::abs)(lhs - rhs) < 1e-5f; };
+    for(int l = 0; l <= 0xFFFF; ++l)
+    {
+        //四个格子的分量轮换排列，每个分量都会遇到四个格子取值的所有组合
+        std::uint8_t a = l >> 12, b = (l >> 8) & 0xF, c = (l >> 4) & 0xF, d = l & 0xF;
+        BlockLight l0 = MakeLight(a, b, c, d);
+        BlockLight l1 = MakeLight(b, c, d, a);
+        BlockLight l2 = MakeLight(c, d, a, b);
+        BlockLight l3 = MakeLight(d, a, b, c);
+        Color ref = Color(0.15f, 0.15f, 0.15f, 0.15f) + 0.85f * 0.25f * (LightToRGBA(l0) + LightToRGBA(l1) +
+                                                                         LightToRGBA(l2) + LightToRGBA(l3));
+        std::uint32_t sum = BlockLightSum(l0, l1, l2, l3);
+
+        VertexLight top = BlockAO(sum, BLOCK_AO_TABLE.top);
+        VW_TEST_CHECK(Near(top.lightColor.x, ref.R()) && Near(top.lightColor.y, ref.G()) &&
+                      Near(top.lightColor.z, ref.B()) && Near(top.sunlight, ref.A()));
+
+        ref *= BLOCK_SIDE_BOTTOM_LIGHT_DEC_RATIO;
+        VertexLight side = BlockAO(sum, BLOCK_AO_TABLE.side);
+        VW_TEST_CHECK(Near(side.lightColor.x, ref.R()) && Near(side.lightColor.y, ref.G()) &&
+                      Near(side.lightColor.z, ref.B()) && Near(side.sunlight, ref.A()));
+    }
+}
@@ -0,0 +1,75 @@
+/*================================================================
+Filename: BlockLightTest.cpp
+Date: 2018.2.20
+Created by AirGuanZ
+================================================================*/
+#include <algorithm>
+#include <cstdint>
+
+#include <Block/Block.h>
+#include <Block/BlockLightBatch.h>
+
+#include "Test.h"
+
+/*
+以逐个分量计算的写法为准，检查SWAR和批量版本
+    单个BlockLight的减法穷举所有取值和衰减量，
+    max和批量版本用一个固定种子的伪随机序列
+*/
+namespace
+{
+    BlockLight ReferenceMax(BlockLight lhs, BlockLight rhs)
+    {
+        return MakeLight(
+            (std::max)(GetRed(lhs),      GetRed(rhs)),
+            (std::max)(GetGreen(lhs),    GetGreen(rhs)),
+            (std::max)(GetBlue(lhs),     GetBlue(rhs)),
+            (std::max)(GetSunlight(lhs), GetSunlight(rhs)));
+    }
+
+    BlockLight ReferenceMinus(BlockLight bl, int dec)
+    {
+        auto Sub = [=](std::uint8_t c)
+        {
+            return static_cast<std::uint8_t>((std::max)(c - dec, static_cast<int>(LIGHT_COMPONENT_MIN)));
+        };
+        return MakeLight(Sub(GetRed(bl)), Sub(GetGreen(bl)), Sub(GetBlue(bl)), Sub(GetSunlight(bl)));
+    }
+}
+
+void TestBlockLight(void)
+{
+    for(int l = 0; l <= 0xFFFF; ++l)
+    {
+        for(int dec = 0; dec <= LIGHT_COMPONENT_MAX + 1; ++dec)
+            VW_TEST_CHECK(BlockLightMinus(static_cast<BlockLight>(l), dec) == ReferenceMinus(static_cast<BlockLight>(l), dec));
+    }
+
+    std::uint32_t seed = 0x9E3779B9;
+    auto Rand = [&]
+    {
+        seed = seed * 1664525 + 1013904223;
+        return static_cast<BlockLight>(seed >> 16);
+    };
+
+    constexpr size_t N = 67; //故意不是向量宽度的倍数
+    BlockLight a[N], b[N], dst[N];
+    for(int round = 0; round != 256; ++round)
+    {
+        for(size_t i = 0; i != N; ++i)
+        {
+            a[i] = Rand(); b[i] = Rand();
+            VW_TEST_CHECK(BlockLightMax(a[i], b[i]) == ReferenceMax(a[i], b[i]));
+        }
+
+        BlockLightMaxBatch(a, b, dst, N);
+        for(size_t i = 0; i != N; ++i)
+            VW_TEST_CHECK(dst[i] == ReferenceMax(a[i], b[i]));
+
+        //dst和输入重合
+        std::copy(a, a + N, dst);
+        BlockLightMaxBatch(dst, b, dst, N);
+        for(size_t i = 0; i != N; ++i)
+            VW_TEST_CHECK(dst[i] == ReferenceMax(a[i], b[i]));
+    }
+}
@@ -0,0 +1,50 @@
+/*================================================================
+Filename: Main.cpp
+Date: 2018.2.20
+Created by AirGuanZ
+================================================================*/
+#include <iostream>
+
+#include "Test.h"
+
+namespace
+{
+    int failureCount = 0;
+}
+
+void Test::Fail(const char *file, int line, const char *cond)
+{
+    std::cout << file << "(" << line << "): check failed: " << cond << std::endl;
+    ++failureCount;
+}
+
+int Test::GetFailureCount(void)
+{
+    return failureCount;
+}
+
+int main(void)
+{
+    struct
+    {
+        const char *name;
+        void (*func)(void);
+    } tests[] =
+    {
+        { "BlockLight", TestBlockLight },
+        { "BlockAO",    TestBlockAO    },
+    };
+
+    int failedTests = 0;
+    for(auto &test : tests)
+    {
+        int before = Test::GetFailureCount();
+        test.func();
+        bool passed = Test::GetFailureCount() == before;
+        std::cout << (passed ? "[  OK  ] " : "[FAILED] ") << test.name << std::endl;
+        if(!passed)
+            ++failedTests;
+    }
+
+    return failedTests ? 1 : 0;
+}
@@ -0,0 +1,26 @@
+/*================================================================
+Filename: Test.h
+Date: 2018.2.20
+Created by AirGuanZ
+================================================================*/
+#pragma once
+
+#include <iostream>
+
+//条件不成立时输出位置和表达式，记一次失败，但不中断当前测试
+#define VW_TEST_CHECK(COND) \
+    do \
+    { \
+        if(!(COND)) \
+            Test::Fail(__FILE__, __LINE__, #COND); \
+    } while(false)
+
+namespace Test
+{
+    void Fail(const char *file, int line, const char *cond);
+
+    int GetFailureCount(void);
+}
+
+void TestBlockLight(void);
+void TestBlockAO(void);
@@ -14,6 +14,9 @@ cbuffer Fog
 Texture2D<float4> tex;
 SamplerState sam;
 
+static const float TEX_GRID_SIZE = 1.0f / 16.0f;
+static const float UV_OFFSET     = 0.0005f;
+
 struct PSInput
 {
     float4 pos        : SV_POSITION;
@@ -21,11 +24,15 @@ struct PSInput
     float3 lightColor : LIGHTCOLOR;
     float  sunlight   : SUNLIGHT;
     float3 posW       : WORLD_POS;
+    float2 texBase    : TEXBASE;
 };
 
 float4 main(PSInput input) : SV_TARGET
 {
-    float4 c = tex.Sample(sam, input.texCoord);
+    float2 local = frac(input.texCoord);
+    float2 uv = input.texBase + UV_OFFSET + local * (TEX_GRID_SIZE - 2.0f * UV_OFFSET);
+    float2 gradCoord = input.texCoord * TEX_GRID_SIZE;
+    float4 c = tex.SampleGrad(sam, uv, ddx(gradCoord), ddy(gradCoord));
     float3 appColor = pow(c * max(input.lightColor, input.sunlight * sunlightColor), 1.65f);
 
     float fogFactor = saturate((distance(input.posW.xz, camPosW.xz) - fogStart) / fogRange);
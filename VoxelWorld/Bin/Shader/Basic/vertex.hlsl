@@ -3,12 +3,18 @@ cbuffer Trans
     float4x4 VP;
 };
 
+cbuffer Section
+{
+    float3 sectionOrigin;
+};
+
+static const float TEX_GRID_SIZE        = 1.0f / 16.0f;
+static const float SIDE_LIGHT_DEC_RATIO = 0.93f;
+static const float LIGHT_COMPONENT_MAX  = 15.0f;
+
 struct VSInput
 {
-    float3 pos        : POSITION;
-    float2 texCoord   : TEXCOORD;
-    float3 lightColor : LIGHTCOLOR;
-    float  sunlight   : SUNLIGHT;
+    uint2 packed : PACKED;
 };
 
 struct VSOutput
@@ -18,15 +24,31 @@ struct VSOutput
     float3 lightColor : LIGHTCOLOR;
     float  sunlight   : SUNLIGHT;
     float3 posW       : WORLD_POS;
+    float2 texBase    : TEXBASE;
 };
 
 VSOutput main(VSInput input)
 {
+    uint geo   = input.packed.x;
+    uint light = input.packed.y;
+
+    float3 local = float3(geo & 31, (geo >> 5) & 31, (geo >> 10) & 31);
+    float2 texCoord = float2((geo >> 15) & 31, (geo >> 20) & 31);
+    uint face = (geo >> 25) & 7;
+
+    float4 lightSum = float4((light >> 18) & 63, (light >> 12) & 63, (light >> 6) & 63, light & 63);
+    float ratio = face == 2 ? 1.0f : SIDE_LIGHT_DEC_RATIO;
+    float4 lightColor = ratio * (0.15f + 0.85f * 0.25f * (lightSum + 2.0f) / (LIGHT_COMPONENT_MAX + 0.5f));
+
+    uint texSlot = light >> 24;
+    float3 posW = sectionOrigin + local;
+
     VSOutput rt = (VSOutput)0;
-    rt.pos        = mul(float4(input.pos, 1.0f), VP);
-    rt.texCoord   = input.texCoord;
-    rt.lightColor = input.lightColor;
-    rt.sunlight   = input.sunlight;
-    rt.posW       = input.pos;
+    rt.pos        = mul(float4(posW, 1.0f), VP);
+    rt.texCoord   = texCoord;
+    rt.lightColor = lightColor.rgb;
+    rt.sunlight   = lightColor.a;
+    rt.posW       = posW;
+    rt.texBase    = float2(texSlot % 16, texSlot / 16) * TEX_GRID_SIZE;
     return rt;
 }